@@ -51,13 +51,68 @@
  */
 @property (nonatomic, strong) AFHTTPClient <AFIncrementalStoreHTTPClient> *HTTPClient;
 
+/**
+ The delegate of the store, which is told how long each phase of fetching and importing took, and which errors occurred.
+ */
+@property (nonatomic, weak) id <AFIncrementalStoreDelegate> delegate;
+
 /**
  The persistent store coordinator used to persist data from the associated web serivices locally.
  
- @discussion Rather than persist values directly, `AFIncrementalStore` manages and proxies through a persistent store coordinator.
+ @discussion Rather than persist values directly, `AFIncrementalStore` manages and proxies through a persistent store coordinator. A persistent store can be added to the coordinator directly, or by specifying `AFIncrementalStoreBackingStoreTypeOption` in the options used to add the incremental store.
  */
 @property (readonly) NSPersistentStoreCoordinator *backingPersistentStoreCoordinator;
 
+/**
+ The maximum number of representations imported from a response before the backing and child contexts are saved. `0` by default, which imports all of the representations in a response at once.
+ 
+ @discussion Each batch is imported within its own autorelease pool, and its objects are turned back into faults once saved. For endpoints that return very large collections, this bounds peak memory use by the batch size rather than by the size of the response.
+ */
+@property (nonatomic, assign) NSUInteger importBatchSize;
+
+/**
+ The maximum depth to which relationship representations embedded in a response are imported. `0` by default, which imports embedded representations at any depth. A depth of `1` only imports the relationships of the representations returned for a request, and not the relationships of those related objects.
+ 
+ @discussion Embedded representations are found with `-representationsForRelationshipsFromRepresentation:ofEntity:fromResponse:`, recursively, so that a compound document, such as an album embedding its tracks, each embedding its artist, fills the object graph in a single request. A resource is not descended into again while its own relationships are being imported, so cyclic graphs are safe to import.
+ */
+@property (nonatomic, assign) NSUInteger maximumRelationshipImportDepth;
+
+/**
+ The maximum number of entries kept in each of the in-memory caches of the store: the caches of backing object IDs, of attribute values, and of relationship values. `0` by default, which sets no limit other than the one imposed by the system.
+
+ @discussion Backing objects are not retained by the backing context once they have been read. Their values are kept in these caches instead, so that faulting the same objects again doesn't go to the backing store, and so that the memory they use can be reclaimed. On iOS, the caches are emptied, and the objects of the backing context turned back into faults, when the application receives a memory warning.
+ */
+@property (nonatomic, assign) NSUInteger cacheCountLimit;
+
+/**
+ The maximum total cost of the entries kept in the caches of attribute and relationship values, where the cost of an entry is an estimate of its size in bytes. `0` by default, which sets no limit other than the one imposed by the system.
+ */
+@property (nonatomic, assign) NSUInteger cacheTotalCostLimit;
+
+///-------------------------------
+/// @name Managing Remote Requests
+///-------------------------------
+
+/**
+ Cancels requests that have been enqueued to fetch the attribute or relationship values of the objects with the specified IDs, but that have not yet started.
+
+ @discussion Requests made for fetch requests are enqueued with a high queue priority, and requests made for faulted attributes and relationships with a low queue priority, so that faults fired while scrolling do not hold up the results being waited on. A request shared by several objects is only cancelled once all of those objects are cancelled. This method is called automatically with the objects that have been unregistered by every managed object context that held them.
+
+ @param objectIDs The IDs of the objects whose pending remote faults should be cancelled.
+ */
+- (void)cancelPendingRemoteFaultsForObjectsWithIDs:(NSArray *)objectIDs;
+
+/**
+ Requests the results of the specified fetch requests, and the values of the relationships along their `relationshipKeyPathsForPrefetching`, and imports them into the backing store ahead of time.
+
+ @discussion This is meant to be called at launch, or before a screen is shown, so that the objects it displays are fetched and faulted from the backing store rather than waiting on the network. Requests go through the same import pipeline as fetch requests executed by a managed object context, but their results are not merged into any of the application's contexts; they are read from the backing store by the fetches made afterwards. Values fetched within the time to live of their entity are not requested again, and neither are relationships for which the HTTP client returns `NO` from `shouldFetchRemoteValuesForRelationship:forObjectWithID:inManagedObjectContext:`.
+
+ @param fetchRequests The fetch requests whose results should be prefetched.
+ @param completion A block to be executed on the main queue once all of the requests have completed, and their results have been saved to the backing store, whether or not they succeeded. This argument may be `nil`.
+ */
+- (void)prefetchResultsOfFetchRequests:(NSArray *)fetchRequests
+                           completion:(void (^)(void))completion;
+
 ///-----------------------
 /// @name Required Methods
 ///-----------------------
@@ -208,6 +263,142 @@
 - (BOOL)shouldFetchRemoteAttributeValuesForObjectWithID:(NSManagedObjectID *)objectID
                                  inManagedObjectContext:(NSManagedObjectContext *)context;
 
+/**
+ Returns a URL request object with a given HTTP method for a set of managed objects of the same entity. When implemented, attribute faults for which `-shouldFetchRemoteAttributeValuesForObjectWithID:inManagedObjectContext:` returns `YES` are collected over a single pass of the managed object context's queue, and fetched together with this request, rather than with one `-requestWithMethod:pathForObjectWithID:withContext:` request each.
+ 
+ @discussion For example, if several `Artist` managed objects fault on their attributes at once, this method might return `GET /artists?ids=1,2,3`. The response is imported in the same way as the response for a fetch request on that entity.
+ 
+ @param method The HTTP method of the request.
+ @param objectIDs The object IDs for the specified managed objects, all of which are of the same entity.
+ @param context The managed object context for the managed objects.
+ 
+ @return An `NSURLRequest` object with the provided HTTP method for the resources corresponding to the managed objects.
+ */
+- (NSURLRequest *)requestWithMethod:(NSString *)method
+              pathForObjectsWithIDs:(NSArray *)objectIDs
+                        withContext:(NSManagedObjectContext *)context;
+
+/**
+ Returns a URL request object for a particular page of the results of the specified fetch request within a particular managed object context. When implemented along with `-pageCursorFollowingPageCursor:ofFetchRequest:withRepresentations:fromResponse:`, this method is used instead of `-requestForFetchRequest:withContext:`, and the results of a fetch request are loaded one page at a time.
+ 
+ @discussion The first page of a fetch request is requested with a `nil` page cursor when the fetch request is executed. Each following page is requested once the first object of the last `fetchBatchSize` objects of the previous page is faulted, which is when a fetched results controller scrolls towards the end of the objects loaded so far. Pages stop being requested once there is no page cursor for the next page, or once `fetchLimit` objects have been loaded. For example, a page cursor might be a page number to translate into `?page=2&per_page=20`, or the identifier of the oldest resource loaded so far to translate into `?max_id=123&count=20`.
+ 
+ @param fetchRequest The fetch request to translate into a URL request.
+ @param pageCursor The page cursor returned for the previous page by `-pageCursorFollowingPageCursor:ofFetchRequest:withRepresentations:fromResponse:`, or `nil` for the first page.
+ @param context The managed object context executing the fetch request.
+ 
+ @return An `NSURLRequest` object corresponding to the specified page of the fetch request.
+ */
+- (NSURLRequest *)requestForFetchRequest:(NSFetchRequest *)fetchRequest
+                          withPageCursor:(id)pageCursor
+                             withContext:(NSManagedObjectContext *)context;
+
+/**
+ Returns the page cursor for the page following the one whose representations came from the specified HTTP response. Page cursors are tracked by the store for each fetch request, as identified by its entity, predicate and sort descriptors.
+ 
+ @param pageCursor The page cursor of the page that was loaded, or `nil` if it was the first page.
+ @param fetchRequest The fetch request whose page was loaded.
+ @param representations The resource representations of the page that was loaded.
+ @param response The HTTP response for the page request.
+ 
+ @return The page cursor used to request the following page, or `nil` if the page that was loaded is the last one.
+ */
+- (id)pageCursorFollowingPageCursor:(id)pageCursor
+                     ofFetchRequest:(NSFetchRequest *)fetchRequest
+                withRepresentations:(NSArray *)representations
+                       fromResponse:(NSHTTPURLResponse *)response;
+
+/**
+ Returns a URL request object for the changes made to the resources of an entity since a particular sync token. When implemented along with `-syncTokenFromResponseObject:ofEntity:fromResponse:` and `-resourceIdentifiersOfDeletedResourcesFromResponseObject:ofEntity:fromResponse:`, executing a fetch request requests the changes to its entity with this method, instead of requesting the resources matching the fetch request with `-requestForFetchRequest:withContext:`.
+ 
+ @discussion The representations of created and updated resources in the response are returned by `-representationOrArrayOfRepresentationsFromResponseObject:`, and imported along with the deletions, in a single save of the backing store and of the context executing the fetch request. The sync token of each entity is persisted in the metadata of the store, and advances once the changes have been saved. For example, this method might return `GET /songs/changes?since=2012-10-01T12:00:00Z`, or `GET /songs` if the sync token is `nil`.
+ 
+ @param entity The entity whose changes are requested.
+ @param syncToken The sync token returned by `-syncTokenFromResponseObject:ofEntity:fromResponse:` for the last changes imported for the entity, or `nil` if none have been imported yet.
+ @param context The managed object context executing the fetch request.
+ 
+ @return An `NSURLRequest` object for the changes made to the resources of the entity since the sync token.
+ */
+- (NSURLRequest *)requestForChangesToEntity:(NSEntityDescription *)entity
+                             sinceSyncToken:(id)syncToken
+                                withContext:(NSManagedObjectContext *)context;
+
+/**
+ Returns the sync token to request the changes following those in the specified response object. The sync token must be a property list object, such as an `NSString` or an `NSNumber`.
+ 
+ @param responseObject The response object returned from the server.
+ @param entity The entity whose changes were requested.
+ @param response The HTTP response for the changes request.
+ 
+ @return The sync token for the next changes request for the entity, or `nil` to keep the current one.
+ */
+- (id)syncTokenFromResponseObject:(id)responseObject
+                         ofEntity:(NSEntityDescription *)entity
+                     fromResponse:(NSHTTPURLResponse *)response;
+
+/**
+ Returns the resource identifiers of the resources reported as deleted, or tombstoned, in the specified response object. The corresponding managed objects are deleted from the backing store and from the context executing the fetch request.
+ 
+ @param responseObject The response object returned from the server.
+ @param entity The entity whose changes were requested.
+ @param response The HTTP response for the changes request.
+ 
+ @return An `NSArray` of resource identifiers, as returned by `-resourceIdentifierForRepresentation:ofEntity:fromResponse:` for the same resources.
+ */
+- (NSArray *)resourceIdentifiersOfDeletedResourcesFromResponseObject:(id)responseObject
+                                                            ofEntity:(NSEntityDescription *)entity
+                                                        fromResponse:(NSHTTPURLResponse *)response;
+
+/**
+ Returns a URL request object to create the resource for a managed object inserted locally. When implemented, inserted objects are recorded in the backing store as they are saved, and sent to the server in the background, so that saving never waits on the network. Changes that fail to be sent are retried with exponential backoff, including after the app is relaunched.
+ 
+ @discussion For example, if a `Post` managed object were inserted, this method might return a `POST /posts` request with the attributes of the post. The resource identifier of the representation in the response, as returned by `-resourceIdentifierForRepresentation:ofEntity:fromResponse:`, replaces the local resource identifier assigned to the object when it was inserted.
+ 
+ @param insertedObject The inserted managed object, in a private context whose faults are fulfilled from the backing store.
+ 
+ @return An `NSURLRequest` object to create the resource, or `nil` if the object should not be sent.
+ */
+- (NSURLRequest *)requestForInsertedObject:(NSManagedObject *)insertedObject;
+
+/**
+ Returns a URL request object to update the resource for a managed object changed locally. When implemented, changes to the attributes and relationships of saved objects are sent to the server in the background, in the same way as inserted objects. An object changed again before its pending update is sent is only sent once, with its latest values.
+ 
+ @discussion For example, if a `Post` managed object were updated, this method might return a `PUT /posts/123` request with the attributes of the post. Objects updated by importing representations from the server are not sent back to it.
+ 
+ @param updatedObject The updated managed object, in a private context whose faults are fulfilled from the backing store.
+ 
+ @return An `NSURLRequest` object to update the resource, or `nil` if the object should not be sent.
+ */
+- (NSURLRequest *)requestForUpdatedObject:(NSManagedObject *)updatedObject;
+
+/**
+ Returns a URL request object to delete the resource for a managed object deleted locally. When implemented, deletions are sent to the server in the background, in the same way as inserted objects. Deleting an object whose insertion has not been sent yet cancels both.
+ 
+ @discussion For example, if a `Post` managed object were deleted, this method might return a `DELETE /posts/123` request.
+ 
+ @param deletedObject The deleted managed object, as a fault whose object ID and entity can be used, but whose values are no longer stored.
+ 
+ @return An `NSURLRequest` object to delete the resource, or `nil` if the object should not be sent.
+ */
+- (NSURLRequest *)requestForDeletedObject:(NSManagedObject *)deletedObject;
+
+/**
+ Returns a URL request object that sends all of the pending local changes at once, for web services with a bulk endpoint. When implemented, this method is used instead of the per-object requests, which are only used if it returns `nil`.
+ 
+ @discussion The representations in the response, as returned by `-representationOrArrayOfRepresentationsFromResponseObject:`, must correspond, in order, to the inserted objects, so that the resource identifiers assigned by the server can be mapped back to them.
+ 
+ @param insertedObjects The inserted managed objects.
+ @param updatedObjects The updated managed objects.
+ @param deletedObjects The deleted managed objects, as faults.
+ @param context The private context of the managed objects.
+ 
+ @return An `NSURLRequest` object to send the changes, or `nil` to send each of them with its own request.
+ */
+- (NSURLRequest *)requestForInsertedObjects:(NSArray *)insertedObjects
+                             updatedObjects:(NSArray *)updatedObjects
+                             deletedObjects:(NSArray *)deletedObjects
+                                withContext:(NSManagedObjectContext *)context;
+
 /**
  Returns whether the client should fetch remote relationship values for a particular managed object. This method is consulted when a managed object faults on a particular relationship, and will call `-requestWithMethod:pathForRelationship:forObjectWithID:withContext:` if `YES`.
  
@@ -221,6 +412,140 @@
                                forObjectWithID:(NSManagedObjectID *)objectID
                         inManagedObjectContext:(NSManagedObjectContext *)context;
 
+/**
+ Returns the time interval for which values fetched for managed objects of a particular entity are considered fresh. When implemented, the store records when each object was last imported, and when each fetch request and relationship request last succeeded.
+
+ @discussion While values are fresh, faults and fetch requests are fulfilled from the backing store alone, and no HTTP request is made. Once they are stale, they are still returned from the backing store right away, and an HTTP request is made in the background to revalidate them. Returning `DBL_MAX` only requests values that have never been fetched, and returning `0` requests them every time, as when this method is not implemented. Fetch requests and relationships use the time to live of the entity they fetch, which for relationships is the destination entity.
+
+ @param entity The entity of the fetched managed objects.
+
+ @return The time interval, in seconds, for which fetched values are fresh.
+ */
+- (NSTimeInterval)timeToLiveForEntity:(NSEntityDescription *)entity;
+
+@end
+
+#pragma mark -
+
+/**
+ The phases of loading remote values into the store, in the order in which they occur.
+ 
+ - `AFIncrementalStoreRequestPhase`: From a request being enqueued until its response is received and parsed by the request operation.
+ - `AFIncrementalStoreResponseMappingPhase`: Turning the response object into representations, with `-representationOrArrayOfRepresentationsFromResponseObject:`.
+ - `AFIncrementalStoreImportPhase`: Mapping a batch of representations onto backing and managed objects.
+ - `AFIncrementalStoreBackingSavePhase`: Saving a batch of imported backing objects to the backing store.
+ - `AFIncrementalStoreChildSavePhase`: Saving a batch of imported managed objects to the context they were fetched for.
+ - `AFIncrementalStoreMergePhase`: Merging the changes of every saved batch into a context.
+ */
+typedef enum {
+    AFIncrementalStoreRequestPhase = 0,
+    AFIncrementalStoreResponseMappingPhase,
+    AFIncrementalStoreImportPhase,
+    AFIncrementalStoreBackingSavePhase,
+    AFIncrementalStoreChildSavePhase,
+    AFIncrementalStoreMergePhase,
+} AFIncrementalStorePhase;
+
+/**
+ The `AFIncrementalStoreDelegate` protocol defines the methods used to observe the performance and errors of an `AFIncrementalStore`. Delegate methods are called on arbitrary queues, as each phase completes, and should return quickly.
+ 
+ @discussion When the store is compiled with `AF_INCREMENTAL_STORE_SIGNPOSTS` defined, each completed phase is also emitted as an `os_signpost` event, which can be seen in Instruments.
+ */
+@protocol AFIncrementalStoreDelegate <NSObject>
+
+@optional
+
+/**
+ Tells the delegate that a phase of loading remote values has completed.
+ 
+ @param incrementalStore The incremental store.
+ @param phase The phase that completed.
+ @param entity The entity of the objects loaded, or `nil` if the phase is not specific to one entity, such as when changes are merged into a context.
+ @param URL The URL of the request or response the objects were loaded with, or `nil` if the phase is not specific to one request.
+ @param duration The time taken by the phase, in seconds.
+ @param numberOfObjects The number of representations or objects handled in the phase, or `0` for `AFIncrementalStoreRequestPhase`.
+ */
+- (void)incrementalStore:(AFIncrementalStore *)incrementalStore
+        didCompletePhase:(AFIncrementalStorePhase)phase
+                ofEntity:(NSEntityDescription *)entity
+                 withURL:(NSURL *)URL
+                duration:(NSTimeInterval)duration
+         numberOfObjects:(NSUInteger)numberOfObjects;
+
+/**
+ Tells the delegate that an error occurred while requesting, importing, or saving values. When this method is not implemented, errors are logged.
+ 
+ @param incrementalStore The incremental store.
+ @param error The error that occurred.
+ */
+- (void)incrementalStore:(AFIncrementalStore *)incrementalStore
+        didFailWithError:(NSError *)error;
+
+@end
+
+#pragma mark -
+
+/**
+ `AFEntityMapping` is a precomputed description of an entity, holding the properties consulted for every representation imported by `AFIncrementalStore`. Each store builds the mappings of the entities of its model once, when it loads its metadata, rather than reflecting on the entity for each record, and keeps them for as long as it exists.
+ 
+ @discussion Entity mappings are immutable, and can be used from any thread.
+ */
+@interface AFEntityMapping : NSObject
+
+/**
+ The entity described by the mapping.
+ */
+@property (readonly, nonatomic, strong) NSEntityDescription *entity;
+
+/**
+ The names of the attributes of the entity, as an array suitable for `NSFetchRequest -propertiesToFetch`.
+ */
+@property (readonly, nonatomic, strong) NSArray *attributeNames;
+
+/**
+ The names of all of the properties of the entity, as a set suitable for membership tests.
+ */
+@property (readonly, nonatomic, strong) NSSet *propertyNames;
+
+/**
+ The attribute descriptions of the entity, keyed by name.
+ */
+@property (readonly, nonatomic, strong) NSDictionary *attributesByName;
+
+/**
+ The relationship descriptions of the entity, keyed by name.
+ */
+@property (readonly, nonatomic, strong) NSDictionary *relationshipsByName;
+
+/**
+ The destination entities of the relationships of the entity, keyed by relationship name.
+ */
+@property (readonly, nonatomic, strong) NSDictionary *destinationEntitiesByRelationshipName;
+
+/**
+ The names of the to-many relationships of the entity.
+ */
+@property (readonly, nonatomic, strong) NSSet *toManyRelationshipNames;
+
+/**
+ The names of the ordered to-many relationships of the entity.
+ */
+@property (readonly, nonatomic, strong) NSSet *orderedRelationshipNames;
+
+/**
+ The value transformers of the transformable attributes of the entity that specify a value transformer name, keyed by attribute name.
+ */
+@property (readonly, nonatomic, strong) NSDictionary *valueTransformersByAttributeName;
+
+/**
+ Initializes a mapping describing the specified entity.
+ 
+ @param entity The entity described by the mapping.
+ 
+ @return The mapping for the entity.
+ */
+- (id)initWithEntity:(NSEntityDescription *)entity;
+
 @end
 
 
@@ -233,3 +558,13 @@
  */
 extern NSString * AFIncrementalStoreUnimplementedMethodException;
 
+/**
+ An option for `NSPersistentStoreCoordinator -addPersistentStoreWithType:configuration:URL:options:error:` specifying the type of the persistent store to add to the backing persistent store coordinator, such as `NSSQLiteStoreType` or `NSBinaryStoreType`. The backing store is added with the model used by the backing persistent store coordinator, and with the same options as the incremental store.
+ */
+extern NSString * AFIncrementalStoreBackingStoreTypeOption;
+
+/**
+ An option for `NSPersistentStoreCoordinator -addPersistentStoreWithType:configuration:URL:options:error:` specifying the `NSURL` of the persistent store to add to the backing persistent store coordinator. If not specified, the URL of the incremental store is used.
+ */
+extern NSString * AFIncrementalStoreBackingStoreURLOption;
+
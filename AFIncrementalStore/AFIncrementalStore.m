@@ -23,29 +23,279 @@
 #import "AFIncrementalStore.h"
 #import "AFHTTPClient.h"
 
+#if defined(__IPHONE_OS_VERSION_MIN_REQUIRED)
+#import <UIKit/UIKit.h>
+#endif
+
+#if defined(AF_INCREMENTAL_STORE_SIGNPOSTS)
+#import <os/signpost.h>
+#endif
+
 NSString * AFIncrementalStoreUnimplementedMethodException = @"com.alamofire.incremental-store.exceptions.unimplemented-method";
 
+NSString * AFIncrementalStoreBackingStoreTypeOption = @"AFIncrementalStoreBackingStoreType";
+NSString * AFIncrementalStoreBackingStoreURLOption = @"AFIncrementalStoreBackingStoreURL";
+
 static NSString * const kAFIncrementalStoreResourceIdentifierAttributeName = @"__af_resourceIdentifier";
+static NSString * const kAFIncrementalStoreVersionAttributeName = @"__af_version";
+static NSString * const kAFIncrementalStoreLastFetchedDateAttributeName = @"__af_lastFetchedDate";
+static NSString * const kAFIncrementalStoreResourceIdentifierSubstitutionVariable = @"RESOURCE_IDENTIFIER";
+static NSString * const kAFIncrementalStoreLocalResourceIdentifierPrefix = @"__af_local_";
+static NSString * const kAFIncrementalStoreMetadataKey = @"AFIncrementalStoreMetadata";
+static NSString * const kAFIncrementalStoreHTTPValidatorsMetadataKey = @"AFIncrementalStoreHTTPValidators";
+static NSString * const kAFIncrementalStoreSyncTokensMetadataKey = @"AFIncrementalStoreSyncTokens";
+static NSString * const kAFIncrementalStoreLastFetchedDatesMetadataKey = @"AFIncrementalStoreLastFetchedDatesByEntityName";
+static NSString * const kAFIncrementalStoreImportContextKey = @"AFIncrementalStoreImportContext";
+static NSString * const kAFIncrementalStoreOutboundChangesMetadataKey = @"AFIncrementalStoreOutboundChanges";
+static NSString * const kAFIncrementalStoreResourceIdentifierAliasesMetadataKey = @"AFIncrementalStoreResourceIdentifierAliases";
+static NSString * const kAFIncrementalStoreOutboundChangeIdentifierKey = @"identifier";
+static NSString * const kAFIncrementalStoreOutboundChangeTypeKey = @"type";
+static NSString * const kAFIncrementalStoreOutboundChangeEntityNameKey = @"entityName";
+static NSString * const kAFIncrementalStoreOutboundChangeResourceIdentifierKey = @"resourceIdentifier";
+static NSTimeInterval const kAFIncrementalStoreMaximumOutboundChangesRetryInterval = 300.0;
+static NSString * const kAFIncrementalStorePaginationFetchRequestKey = @"fetchRequest";
+static NSString * const kAFIncrementalStorePaginationPageCursorKey = @"pageCursor";
+static NSString * const kAFIncrementalStorePaginationNumberOfObjectsKey = @"numberOfObjects";
+static NSString * const kAFIncrementalStorePaginationThresholdObjectIDKey = @"thresholdObjectID";
+static NSString * const kAFIncrementalStoreRowAttributeValuesKey = @"attributeValues";
+static NSString * const kAFIncrementalStoreRowRelationshipValuesKey = @"relationshipValues";
+static NSString * const kAFIncrementalStoreRowVersionKey = @"version";
+static NSString * const kAFIncrementalStoreRowLastFetchedDateKey = @"lastFetchedDate";
+
+static NSString * AFRequestSignature(NSURLRequest *request) {
+    return [NSString stringWithFormat:@"%@ %@", [request HTTPMethod], [[request URL] absoluteString]];
+}
+
+#if defined(AF_INCREMENTAL_STORE_SIGNPOSTS)
+static const char * AFIncrementalStorePhaseName(AFIncrementalStorePhase phase) {
+    switch (phase) {
+        case AFIncrementalStoreRequestPhase:
+            return "Request";
+        case AFIncrementalStoreResponseMappingPhase:
+            return "Response Mapping";
+        case AFIncrementalStoreImportPhase:
+            return "Import";
+        case AFIncrementalStoreBackingSavePhase:
+            return "Backing Save";
+        case AFIncrementalStoreChildSavePhase:
+            return "Child Save";
+        case AFIncrementalStoreMergePhase:
+            return "Merge";
+    }
+    
+    return "Unknown";
+}
+#endif
+
+static NSUInteger AFEstimatedCostOfValue(id value) {
+    if ([value isKindOfClass:[NSString class]]) {
+        return [value length] * sizeof(unichar);
+    } else if ([value isKindOfClass:[NSData class]]) {
+        return [value length];
+    } else if ([value isKindOfClass:[NSDictionary class]]) {
+        NSUInteger cost = 0;
+        for (id key in value) {
+            cost += AFEstimatedCostOfValue([value objectForKey:key]);
+        }
+        
+        return cost;
+    } else if ([value respondsToSelector:@selector(count)]) {
+        return [value count] * sizeof(id);
+    }
+    
+    return sizeof(id);
+}
+
+static BOOL AFManagedObjectValueIsEqualToValue(id value, id otherValue) {
+    return value == otherValue || [value isEqual:otherValue];
+}
+
+static void AFSetChangedValueForKey(NSManagedObject *managedObject, id value, NSString *key) {
+    if ([value isEqual:[NSNull null]]) {
+        value = nil;
+    }
+    
+    // Assigning a value that is already set would still mark the object as updated, and cause it to be written and merged on the next save
+    if (!AFManagedObjectValueIsEqualToValue([managedObject valueForKey:key], value)) {
+        [managedObject setValue:value forKey:key];
+    }
+}
+
+static void AFSetChangedValuesForKeysWithDictionary(NSManagedObject *managedObject, NSDictionary *keyedValues) {
+    [keyedValues enumerateKeysAndObjectsUsingBlock:^(id key, id value, __unused BOOL *stop) {
+        AFSetChangedValueForKey(managedObject, value, key);
+    }];
+}
+
+static NSString * AFBackingObjectFetchRequestTemplateName(NSEntityDescription *entity) {
+    return [NSString stringWithFormat:@"AFIncrementalStoreBackingObject%@", [entity name]];
+}
+
+static NSString * AFFetchRequestSignature(NSFetchRequest *fetchRequest) {
+    return [NSString stringWithFormat:@"%@ %@ %@", fetchRequest.entityName, [fetchRequest.predicate predicateFormat], [[fetchRequest.sortDescriptors valueForKey:@"description"] componentsJoinedByString:@","]];
+}
+
+static NSString * AFRootEntityName(NSEntityDescription *entity) {
+    while ([entity superentity]) {
+        entity = [entity superentity];
+    }
+    
+    return [entity name];
+}
+
+static BOOL AFRequestIsCoalescable(NSURLRequest *request) {
+    return [[request HTTPMethod] isEqualToString:@"GET"] || [[request HTTPMethod] isEqualToString:@"HEAD"];
+}
 
 @interface AFIncrementalStore ()
+- (AFEntityMapping *)mappingForEntity:(NSEntityDescription *)entity;
 - (NSManagedObjectContext *)backingManagedObjectContext;
+- (NSManagedObjectContext *)newImportBackingManagedObjectContext;
+- (NSSet *)entityNamesAffectedByImportOfEntity:(NSEntityDescription *)entity;
 - (NSManagedObjectID *)objectIDForEntity:(NSEntityDescription *)entity
                   withResourceIdentifier:(NSString *)resourceIdentifier;
 - (NSManagedObjectID *)objectIDForBackingObjectForEntity:(NSEntityDescription *)entity
                                   withResourceIdentifier:(NSString *)resourceIdentifier;
+- (NSDictionary *)objectIDsForBackingObjectsForEntity:(NSEntityDescription *)entity
+                              withResourceIdentifiers:(NSSet *)resourceIdentifiers
+                                     inBackingContext:(NSManagedObjectContext *)backingContext;
+- (NSDictionary *)resourceIdentifiersByEntityNameForRepresentations:(NSArray *)representations
+                                                           ofEntity:(NSEntityDescription *)entity
+                                                       fromResponse:(NSHTTPURLResponse *)response;
+- (void)cacheBackingObjectID:(NSManagedObjectID *)backingObjectID
+                   forEntity:(NSEntityDescription *)entity
+      withResourceIdentifier:(NSString *)resourceIdentifier;
+- (void)cacheBackingObjectIDsOfBackingObjects:(id <NSFastEnumeration>)backingObjects;
+- (NSArray *)objectIDsForBackingObjectIDs:(NSArray *)backingObjectIDs
+                                 ofEntity:(NSEntityDescription *)entity
+                                batchSize:(NSUInteger)batchSize
+                                    error:(NSError *__autoreleasing *)error;
+- (void)backingManagedObjectContextWillSave:(NSNotification *)notification;
+- (void)backingManagedObjectContextDidSave:(NSNotification *)notification;
+- (void)backingPersistentStoreCoordinatorStoresDidChange:(NSNotification *)notification;
+- (void)didReceiveMemoryWarning:(NSNotification *)notification;
+- (void)didCompletePhase:(AFIncrementalStorePhase)phase
+                ofEntity:(NSEntityDescription *)entity
+                 withURL:(NSURL *)URL
+               startTime:(CFAbsoluteTime)startTime
+         numberOfObjects:(NSUInteger)numberOfObjects;
+- (void)didFailWithError:(NSError *)error;
+- (id)metadataValueForKey:(NSString *)key;
+- (void)setMetadataValue:(id)value
+                  forKey:(NSString *)key;
+- (void)updateMetadataValueForKey:(NSString *)key
+                       usingBlock:(id (^)(id value))block;
+- (NSURLRequest *)conditionalRequestForRequest:(NSURLRequest *)request;
+- (void)setHTTPValidatorsForRequest:(NSURLRequest *)request
+                       fromResponse:(NSHTTPURLResponse *)response;
+- (BOOL)removeHTTPValidatorsForRequest:(NSURLRequest *)request;
+- (NSDate *)lastFetchedDateForKey:(NSString *)key
+                         ofEntity:(NSEntityDescription *)entity;
+- (void)setLastFetchedDateForKey:(NSString *)key
+                        ofEntity:(NSEntityDescription *)entity;
+- (BOOL)isFreshLastFetchedDate:(NSDate *)lastFetchedDate
+                     forEntity:(NSEntityDescription *)entity;
+- (AFHTTPRequestOperation *)enqueueHTTPRequestOperationWithRequest:(NSURLRequest *)request
+                                                           success:(void (^)(AFHTTPRequestOperation *operation, id responseObject))success
+                                                           failure:(void (^)(AFHTTPRequestOperation *operation, NSError *error))failure;
+- (AFHTTPRequestOperation *)enqueueHTTPRequestOperationWithRequest:(NSURLRequest *)request
+                                                     queuePriority:(NSOperationQueuePriority)queuePriority
+                                       forFaultsOfObjectsWithIDs:(NSArray *)objectIDs
+                                                           success:(void (^)(AFHTTPRequestOperation *operation, id responseObject))success
+                                                           failure:(void (^)(AFHTTPRequestOperation *operation, NSError *error))failure;
+- (void)importRepresentations:(NSArray *)representations
+                     ofEntity:(NSEntityDescription *)entity
+                 fromResponse:(NSHTTPURLResponse *)response
+                  withContext:(NSManagedObjectContext *)context;
+- (void)importRepresentations:(NSArray *)representations
+                     ofEntity:(NSEntityDescription *)entity
+   deletedResourceIdentifiers:(NSArray *)deletedResourceIdentifiers
+              forRelationship:(NSRelationshipDescription *)relationship
+               ofObjectWithID:(NSManagedObjectID *)objectID
+                 fromResponse:(NSHTTPURLResponse *)response
+                  withContext:(NSManagedObjectContext *)context
+                   completion:(void (^)(BOOL didImportAllBatches))completion;
+- (void)enqueueRemoteChangesFetchForEntity:(NSEntityDescription *)entity
+                               withContext:(NSManagedObjectContext *)context
+                                completion:(void (^)(void))completion;
+- (void)enqueueRemoteFetchRequest:(NSFetchRequest *)fetchRequest
+                   withPageCursor:(id)pageCursor
+                      withContext:(NSManagedObjectContext *)context
+                       completion:(void (^)(void))completion;
+- (void)enqueueRemoteFetchForRelationship:(NSRelationshipDescription *)relationship
+                           ofObjectWithID:(NSManagedObjectID *)objectID
+                              withContext:(NSManagedObjectContext *)context
+                               completion:(void (^)(void))completion;
+- (void)prefetchRelationshipKeyPaths:(NSArray *)keyPaths
+                    ofObjectsWithIDs:(NSArray *)objectIDs
+                            ofEntity:(NSEntityDescription *)entity
+                         withContext:(NSManagedObjectContext *)context
+                          completion:(void (^)(void))completion;
+- (void)setPaginationState:(NSDictionary *)paginationState
+  forFetchRequestSignature:(NSString *)fetchRequestSignature;
+- (void)enqueueNextPageIfNeededForObjectWithID:(NSManagedObjectID *)objectID
+                                   withContext:(NSManagedObjectContext *)context;
+- (void)enqueueRemoteAttributeValuesFetchForObjectWithID:(NSManagedObjectID *)objectID
+                                             withContext:(NSManagedObjectContext *)context;
+- (void)fetchRemoteAttributeValuesForPendingObjectsWithContext:(NSManagedObjectContext *)context;
+- (id)executeSaveChangesRequest:(NSSaveChangesRequest *)saveChangesRequest
+                    withContext:(NSManagedObjectContext *)context
+                          error:(NSError *__autoreleasing *)error;
+- (void)recordOutboundChanges:(NSArray *)outboundChanges;
+- (void)sendOutboundChanges;
+- (void)didSendOutboundChanges:(NSArray *)outboundChanges
+         failedOutboundChanges:(NSArray *)failedOutboundChanges;
+- (void)setResourceIdentifierFromResponseObject:(id)responseObject
+                 ofInsertedObjectWithLocalResourceIdentifier:(NSString *)localResourceIdentifier
+                                        ofEntity:(NSEntityDescription *)entity
+                                    fromResponse:(NSHTTPURLResponse *)response;
+- (void)enqueueMergeOfInsertedObjects:(NSSet *)insertedObjects
+                       updatedObjects:(NSSet *)updatedObjects
+                       deletedObjects:(NSSet *)deletedObjects
+                          intoContext:(NSManagedObjectContext *)context;
+- (void)mergePendingChangesIntoContext:(NSManagedObjectContext *)context;
 @end
 
 @implementation AFIncrementalStore {
 @private
+    NSDictionary *_entityMappingsByEntityName;
     NSCache *_propertyValuesCache;
     NSCache *_relationshipsCache;
     NSCache *_backingObjectIDByObjectID;
-    NSMutableDictionary *_registeredObjectIDsByResourceIdentifier;
+    NSCache *_objectIDByBackingObjectID;
+    NSMutableDictionary *_registeredObjectIDsByResourceIdentifierByEntityName;
+    NSCountedSet *_registeredObjectIDs;
+    dispatch_queue_t _registeredObjectIDsQueue;
     NSPersistentStoreCoordinator *_backingPersistentStoreCoordinator;
     NSManagedObjectContext *_backingManagedObjectContext;
+    NSMutableDictionary *_callbacksByRequestSignature;
+    NSMutableDictionary *_HTTPRequestOperationsByRequestSignature;
+    NSMutableDictionary *_faultObjectIDsByRequestSignature;
+    NSMutableDictionary *_faultRequestSignaturesByObjectID;
+    dispatch_queue_t _requestCoalescingQueue;
+    NSMutableDictionary *_pendingAttributeFaultObjectIDsByContext;
+    dispatch_queue_t _attributeFaultBatchingQueue;
+    dispatch_queue_t _metadataQueue;
+    NSMutableDictionary *_paginationStatesByFetchRequestSignature;
+    NSMutableDictionary *_fetchRequestSignaturesByThresholdObjectID;
+    NSMutableDictionary *_paginationStatesFollowingRequestSignature;
+    dispatch_queue_t _paginationQueue;
+    NSMutableDictionary *_pendingChangesByContext;
+    dispatch_queue_t _changeMergingQueue;
+    dispatch_queue_t _outboundChangesQueue;
+    NSArray *_outboundChangesInFlight;
+    NSTimeInterval _outboundChangesRetryInterval;
+    NSOperationQueue *_importOperationQueue;
+    NSMutableDictionary *_lastImportOperationsByEntityName;
+    dispatch_queue_t _importSchedulingQueue;
 }
 @synthesize HTTPClient = _HTTPClient;
+@synthesize delegate = _delegate;
 @synthesize backingPersistentStoreCoordinator = _backingPersistentStoreCoordinator;
+@synthesize importBatchSize = _importBatchSize;
+@synthesize maximumRelationshipImportDepth = _maximumRelationshipImportDepth;
+@synthesize cacheCountLimit = _cacheCountLimit;
+@synthesize cacheTotalCostLimit = _cacheTotalCostLimit;
 
 + (NSString *)type {
     @throw([NSException exceptionWithName:AFIncrementalStoreUnimplementedMethodException reason:NSLocalizedString(@"Unimplemented method: +type. Must be overridden in a subclass", nil) userInfo:nil]);
@@ -65,7 +315,39 @@ static NSString * const kAFIncrementalStoreResourceIdentifierAttributeName = @"_
         _propertyValuesCache = [[NSCache alloc] init];
         _relationshipsCache = [[NSCache alloc] init];
         _backingObjectIDByObjectID = [[NSCache alloc] init];
-        _registeredObjectIDsByResourceIdentifier = [[NSMutableDictionary alloc] init];
+        _objectIDByBackingObjectID = [[NSCache alloc] init];
+        [self setCacheCountLimit:_cacheCountLimit];
+        [self setCacheTotalCostLimit:_cacheTotalCostLimit];
+        _registeredObjectIDsByResourceIdentifierByEntityName = [[NSMutableDictionary alloc] init];
+        _registeredObjectIDs = [[NSCountedSet alloc] init];
+        _registeredObjectIDsQueue = dispatch_queue_create("com.alamofire.incremental-store.registered-object-ids", DISPATCH_QUEUE_CONCURRENT);
+        _callbacksByRequestSignature = [[NSMutableDictionary alloc] init];
+        _HTTPRequestOperationsByRequestSignature = [[NSMutableDictionary alloc] init];
+        _faultObjectIDsByRequestSignature = [[NSMutableDictionary alloc] init];
+        _faultRequestSignaturesByObjectID = [[NSMutableDictionary alloc] init];
+        _requestCoalescingQueue = dispatch_queue_create("com.alamofire.incremental-store.request-coalescing", DISPATCH_QUEUE_SERIAL);
+        _pendingAttributeFaultObjectIDsByContext = [[NSMutableDictionary alloc] init];
+        _attributeFaultBatchingQueue = dispatch_queue_create("com.alamofire.incremental-store.attribute-fault-batching", DISPATCH_QUEUE_SERIAL);
+        _metadataQueue = dispatch_queue_create("com.alamofire.incremental-store.metadata", DISPATCH_QUEUE_SERIAL);
+        _paginationStatesByFetchRequestSignature = [[NSMutableDictionary alloc] init];
+        _fetchRequestSignaturesByThresholdObjectID = [[NSMutableDictionary alloc] init];
+        _paginationStatesFollowingRequestSignature = [[NSMutableDictionary alloc] init];
+        _paginationQueue = dispatch_queue_create("com.alamofire.incremental-store.pagination", DISPATCH_QUEUE_SERIAL);
+        _pendingChangesByContext = [[NSMutableDictionary alloc] init];
+        _changeMergingQueue = dispatch_queue_create("com.alamofire.incremental-store.change-merging", DISPATCH_QUEUE_SERIAL);
+        _outboundChangesQueue = dispatch_queue_create("com.alamofire.incremental-store.outbound-changes", DISPATCH_QUEUE_SERIAL);
+        _importOperationQueue = [[NSOperationQueue alloc] init];
+        [_importOperationQueue setMaxConcurrentOperationCount:[[NSProcessInfo processInfo] activeProcessorCount]];
+        _lastImportOperationsByEntityName = [[NSMutableDictionary alloc] init];
+        _importSchedulingQueue = dispatch_queue_create("com.alamofire.incremental-store.import-scheduling", DISPATCH_QUEUE_SERIAL);
+        
+        // Entity mappings are built up front, so that importing representations never has to reflect on the model. They are held by the store, and go away with it and its model
+        NSArray *entities = self.persistentStoreCoordinator.managedObjectModel.entities;
+        NSMutableDictionary *mutableEntityMappingsByEntityName = [NSMutableDictionary dictionaryWithCapacity:[entities count]];
+        for (NSEntityDescription *entity in entities) {
+            [mutableEntityMappingsByEntityName setObject:[[AFEntityMapping alloc] initWithEntity:entity] forKey:[entity name]];
+        }
+        _entityMappingsByEntityName = [NSDictionary dictionaryWithDictionary:mutableEntityMappingsByEntityName];
         
         NSManagedObjectModel *model = [self.persistentStoreCoordinator.managedObjectModel copy];
         for (NSEntityDescription *entity in model.entities) {
@@ -78,10 +360,46 @@ static NSString * const kAFIncrementalStoreResourceIdentifierAttributeName = @"_
             [resourceIdentifierProperty setName:kAFIncrementalStoreResourceIdentifierAttributeName];
             [resourceIdentifierProperty setAttributeType:NSStringAttributeType];
             [resourceIdentifierProperty setIndexed:YES];
-            [entity setProperties:[entity.properties arrayByAddingObject:resourceIdentifierProperty]];
+            
+            // The version of each backing object is incremented whenever it is saved with changes, and reported in the nodes returned to Core Data
+            NSAttributeDescription *versionProperty = [[NSAttributeDescription alloc] init];
+            [versionProperty setName:kAFIncrementalStoreVersionAttributeName];
+            [versionProperty setAttributeType:NSInteger64AttributeType];
+            [versionProperty setDefaultValue:[NSNumber numberWithLongLong:1]];
+            
+            // The date each backing object was last imported decides, together with the time to live of its entity, whether its attribute faults are fetched again
+            NSAttributeDescription *lastFetchedDateProperty = [[NSAttributeDescription alloc] init];
+            [lastFetchedDateProperty setName:kAFIncrementalStoreLastFetchedDateAttributeName];
+            [lastFetchedDateProperty setAttributeType:NSDateAttributeType];
+            [lastFetchedDateProperty setOptional:YES];
+            
+            [entity setProperties:[entity.properties arrayByAddingObjectsFromArray:[NSArray arrayWithObjects:resourceIdentifierProperty, versionProperty, lastFetchedDateProperty, nil]]];
+        }
+        
+        // Backing objects are looked up by resource identifier from a template built once per entity, so that faulting never has to parse a predicate format string
+        NSPredicate *resourceIdentifierPredicate = [NSPredicate predicateWithFormat:@"%K = $RESOURCE_IDENTIFIER", kAFIncrementalStoreResourceIdentifierAttributeName];
+        for (NSEntityDescription *entity in model.entities) {
+            NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] init];
+            fetchRequest.entity = entity;
+            fetchRequest.fetchLimit = 1;
+            fetchRequest.predicate = resourceIdentifierPredicate;
+            [model setFetchRequestTemplate:fetchRequest forName:AFBackingObjectFetchRequestTemplateName(entity)];
         }
         
         _backingPersistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:model];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(backingPersistentStoreCoordinatorStoresDidChange:) name:NSPersistentStoreCoordinatorStoresDidChangeNotification object:_backingPersistentStoreCoordinator];
+#if defined(__IPHONE_OS_VERSION_MIN_REQUIRED)
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+#endif
+        
+        // The remaining options, such as `NSMigratePersistentStoresAutomaticallyOption`, are passed along to the backing store
+        NSString *backingStoreType = [self.options valueForKey:AFIncrementalStoreBackingStoreTypeOption];
+        if (backingStoreType) {
+            NSURL *backingStoreURL = [self.options valueForKey:AFIncrementalStoreBackingStoreURLOption] ?: [self URL];
+            if (![_backingPersistentStoreCoordinator addPersistentStoreWithType:backingStoreType configuration:nil URL:backingStoreURL options:self.options error:error]) {
+                return NO;
+            }
+        }
         
         return YES;
     } else {
@@ -89,19 +407,249 @@ static NSString * const kAFIncrementalStoreResourceIdentifierAttributeName = @"_
     }
 }
 
+- (void)setMetadata:(NSDictionary *)metadata {
+    [super setMetadata:metadata];
+    
+    // Metadata is written through to the backing stores, so that the store UUID, and with it any archived object URIs or fetched results controller caches, remain valid across launches
+    for (NSPersistentStore *backingPersistentStore in [_backingPersistentStoreCoordinator persistentStores]) {
+        NSMutableDictionary *mutableBackingMetadata = [[_backingPersistentStoreCoordinator metadataForPersistentStore:backingPersistentStore] mutableCopy];
+        [mutableBackingMetadata setValue:metadata forKey:kAFIncrementalStoreMetadataKey];
+        [_backingPersistentStoreCoordinator setMetadata:mutableBackingMetadata forPersistentStore:backingPersistentStore];
+    }
+}
+
+- (void)backingPersistentStoreCoordinatorStoresDidChange:(NSNotification *)notification {
+    for (NSPersistentStore *backingPersistentStore in [[notification userInfo] objectForKey:NSAddedPersistentStoresKey]) {
+        NSMutableDictionary *mutableMetadata = [[self metadata] mutableCopy];
+        [mutableMetadata addEntriesFromDictionary:[[_backingPersistentStoreCoordinator metadataForPersistentStore:backingPersistentStore] valueForKey:kAFIncrementalStoreMetadataKey]];
+        [mutableMetadata setValue:NSStringFromClass([self class]) forKey:NSStoreTypeKey];
+        [self setMetadata:mutableMetadata];
+    }
+    
+    // Changes saved while offline, or while the app was last running, are sent once the HTTP client has had a chance to be set up
+    if ([[self metadataValueForKey:kAFIncrementalStoreOutboundChangesMetadataKey] count] > 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self sendOutboundChanges];
+        });
+    }
+}
+
+- (id)metadataValueForKey:(NSString *)key {
+    __block id value = nil;
+    dispatch_sync(_metadataQueue, ^{
+        value = [[self metadata] valueForKey:key];
+    });
+    
+    return value;
+}
+
+- (void)setMetadataValue:(id)value
+                  forKey:(NSString *)key
+{
+    [self updateMetadataValueForKey:key usingBlock:^id(__unused id previousValue) {
+        return value;
+    }];
+}
+
+- (void)updateMetadataValueForKey:(NSString *)key
+                       usingBlock:(id (^)(id value))block
+{
+    // The value is read, transformed, and written back in a single block on the metadata queue, so that updates made concurrently by import completions are not lost. Returning the value passed in leaves the metadata untouched
+    dispatch_sync(_metadataQueue, ^{
+        id value = [[self metadata] valueForKey:key];
+        id updatedValue = block(value);
+        if (updatedValue == value) {
+            return;
+        }
+        
+        NSMutableDictionary *mutableMetadata = [[self metadata] mutableCopy];
+        [mutableMetadata setValue:updatedValue forKey:key];
+        [self setMetadata:mutableMetadata];
+    });
+}
+
 - (NSManagedObjectContext *)backingManagedObjectContext {
     if (!_backingManagedObjectContext) {
-        _backingManagedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
+        _backingManagedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
         _backingManagedObjectContext.persistentStoreCoordinator = _backingPersistentStoreCoordinator;
-        _backingManagedObjectContext.retainsRegisteredObjects = YES;
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(backingManagedObjectContextWillSave:) name:NSManagedObjectContextWillSaveNotification object:_backingManagedObjectContext];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(backingManagedObjectContextDidSave:) name:NSManagedObjectContextDidSaveNotification object:_backingManagedObjectContext];
     }
     
     return _backingManagedObjectContext;
 }
 
+- (void)setCacheCountLimit:(NSUInteger)cacheCountLimit {
+    _cacheCountLimit = cacheCountLimit;
+    
+    [_propertyValuesCache setCountLimit:cacheCountLimit];
+    [_relationshipsCache setCountLimit:cacheCountLimit];
+    [_backingObjectIDByObjectID setCountLimit:cacheCountLimit];
+    [_objectIDByBackingObjectID setCountLimit:cacheCountLimit];
+}
+
+- (void)setCacheTotalCostLimit:(NSUInteger)cacheTotalCostLimit {
+    _cacheTotalCostLimit = cacheTotalCostLimit;
+    
+    [_propertyValuesCache setTotalCostLimit:cacheTotalCostLimit];
+    [_relationshipsCache setTotalCostLimit:cacheTotalCostLimit];
+}
+
+- (void)didReceiveMemoryWarning:(NSNotification *)notification {
+    [_propertyValuesCache removeAllObjects];
+    [_relationshipsCache removeAllObjects];
+    [_backingObjectIDByObjectID removeAllObjects];
+    [_objectIDByBackingObjectID removeAllObjects];
+    
+    // Backing objects without unsaved changes are turned back into faults, releasing their row data until they are next read
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    [backingContext performBlock:^{
+        for (NSManagedObject *backingObject in [backingContext registeredObjects]) {
+            if (![backingObject isFault] && ![backingObject hasChanges]) {
+                [backingContext refreshObject:backingObject mergeChanges:NO];
+            }
+        }
+    }];
+}
+
+- (void)didCompletePhase:(AFIncrementalStorePhase)phase
+                ofEntity:(NSEntityDescription *)entity
+                 withURL:(NSURL *)URL
+               startTime:(CFAbsoluteTime)startTime
+         numberOfObjects:(NSUInteger)numberOfObjects
+{
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    
+#if defined(AF_INCREMENTAL_STORE_SIGNPOSTS)
+    static os_log_t _signpostLog = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _signpostLog = os_log_create("com.alamofire.incremental-store", "Pipeline");
+    });
+    
+    os_signpost_event_emit(_signpostLog, OS_SIGNPOST_ID_EXCLUSIVE, "Phase", "%{public}s %{public}@ %{public}@ duration:%.3fms objects:%lu", AFIncrementalStorePhaseName(phase), entity.name, [URL absoluteString], duration * 1000.0, (unsigned long)numberOfObjects);
+#endif
+    
+    id <AFIncrementalStoreDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(incrementalStore:didCompletePhase:ofEntity:withURL:duration:numberOfObjects:)]) {
+        [delegate incrementalStore:self didCompletePhase:phase ofEntity:entity withURL:URL duration:duration numberOfObjects:numberOfObjects];
+    }
+}
+
+- (void)didFailWithError:(NSError *)error {
+    id <AFIncrementalStoreDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(incrementalStore:didFailWithError:)]) {
+        [delegate incrementalStore:self didFailWithError:error];
+    } else {
+        NSLog(@"Error: %@", error);
+    }
+}
+
+- (NSManagedObjectContext *)newImportBackingManagedObjectContext {
+    NSManagedObjectContext *backingContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    backingContext.persistentStoreCoordinator = _backingPersistentStoreCoordinator;
+    backingContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(backingManagedObjectContextWillSave:) name:NSManagedObjectContextWillSaveNotification object:backingContext];
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(backingManagedObjectContextDidSave:) name:NSManagedObjectContextDidSaveNotification object:backingContext];
+    
+    return backingContext;
+}
+
+- (NSSet *)entityNamesAffectedByImportOfEntity:(NSEntityDescription *)entity {
+    NSMutableSet *mutableEntityNames = [NSMutableSet setWithObject:[entity name]];
+    NSArray *entities = [NSArray arrayWithObject:entity];
+    for (NSUInteger depth = 0; [entities count] > 0 && (self.maximumRelationshipImportDepth == 0 || depth < self.maximumRelationshipImportDepth); depth++) {
+        NSMutableArray *mutableDestinationEntities = [NSMutableArray array];
+        for (NSEntityDescription *sourceEntity in entities) {
+            for (NSEntityDescription *destinationEntity in [[[self mappingForEntity:sourceEntity] destinationEntitiesByRelationshipName] allValues]) {
+                if (![mutableEntityNames containsObject:[destinationEntity name]]) {
+                    [mutableEntityNames addObject:[destinationEntity name]];
+                    [mutableDestinationEntities addObject:destinationEntity];
+                }
+            }
+        }
+        
+        entities = mutableDestinationEntities;
+    }
+    
+    return mutableEntityNames;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    
+    if (_registeredObjectIDsQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_registeredObjectIDsQueue);
+#endif
+        _registeredObjectIDsQueue = NULL;
+    }
+    
+    if (_requestCoalescingQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_requestCoalescingQueue);
+#endif
+        _requestCoalescingQueue = NULL;
+    }
+    
+    if (_attributeFaultBatchingQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_attributeFaultBatchingQueue);
+#endif
+        _attributeFaultBatchingQueue = NULL;
+    }
+    
+    if (_metadataQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_metadataQueue);
+#endif
+        _metadataQueue = NULL;
+    }
+    
+    if (_paginationQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_paginationQueue);
+#endif
+        _paginationQueue = NULL;
+    }
+    
+    if (_changeMergingQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_changeMergingQueue);
+#endif
+        _changeMergingQueue = NULL;
+    }
+    
+    if (_outboundChangesQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_outboundChangesQueue);
+#endif
+        _outboundChangesQueue = NULL;
+    }
+    
+    if (_importSchedulingQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_importSchedulingQueue);
+#endif
+        _importSchedulingQueue = NULL;
+    }
+}
+
+- (AFEntityMapping *)mappingForEntity:(NSEntityDescription *)entity {
+    // Mappings are never added once the metadata is loaded, so they are read without synchronization
+    return entity ? [_entityMappingsByEntityName objectForKey:[entity name]] : nil;
+}
+
 - (NSManagedObjectID *)objectIDForEntity:(NSEntityDescription *)entity
                   withResourceIdentifier:(NSString *)resourceIdentifier {
-    NSManagedObjectID *objectID = [_registeredObjectIDsByResourceIdentifier objectForKey:resourceIdentifier];
+    // Lookups from concurrent imports run in parallel on the registry queue, and only wait for registrations, which are submitted as barriers. Objects are registered under their root entity, like resource identifiers in the backing store, so that looking up a superentity finds an object registered as one of its subentities
+    __block NSManagedObjectID *objectID = nil;
+    dispatch_sync(_registeredObjectIDsQueue, ^{
+        objectID = [[_registeredObjectIDsByResourceIdentifierByEntityName objectForKey:AFRootEntityName(entity)] objectForKey:resourceIdentifier];
+    });
+    
     if (objectID == nil) {
         objectID = [self newObjectIDForEntity:entity referenceObject:resourceIdentifier];
     }
@@ -116,325 +664,1854 @@ static NSString * const kAFIncrementalStoreResourceIdentifierAttributeName = @"_
         return nil;
     }
     
-    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:[entity name]];
+    NSManagedObjectID *backingObjectID = [_backingObjectIDByObjectID objectForKey:[self objectIDForEntity:entity withResourceIdentifier:resourceIdentifier]];
+    if (backingObjectID) {
+        return backingObjectID;
+    }
+    
+    NSFetchRequest *fetchRequest = [_backingPersistentStoreCoordinator.managedObjectModel fetchRequestFromTemplateWithName:AFBackingObjectFetchRequestTemplateName(entity) substitutionVariables:[NSDictionary dictionaryWithObject:resourceIdentifier forKey:kAFIncrementalStoreResourceIdentifierSubstitutionVariable]];
     fetchRequest.resultType = NSManagedObjectIDResultType;
-    fetchRequest.fetchLimit = 1;
-    fetchRequest.predicate = [NSPredicate predicateWithFormat:@"%K = %@", kAFIncrementalStoreResourceIdentifierAttributeName, resourceIdentifier];
     
-    NSError *error = nil;
-    NSArray *results = [[self backingManagedObjectContext] executeFetchRequest:fetchRequest error:&error];
+    __block NSArray *results = nil;
+    __block NSError *error = nil;
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    [backingContext performBlockAndWait:^{
+        results = [backingContext executeFetchRequest:fetchRequest error:&error];
+    }];
+    
     if (error) {
-        NSLog(@"Error: %@", error);
+        [self didFailWithError:error];
         return nil;
     }
     
-    return [results lastObject];
+    backingObjectID = [results lastObject];
+    [self cacheBackingObjectID:backingObjectID forEntity:entity withResourceIdentifier:resourceIdentifier];
+    
+    return backingObjectID;
 }
 
-- (id)executeRequest:(NSPersistentStoreRequest *)persistentStoreRequest
-         withContext:(NSManagedObjectContext *)context
-               error:(NSError *__autoreleasing *)error
+- (NSDictionary *)objectIDsForBackingObjectsForEntity:(NSEntityDescription *)entity
+                              withResourceIdentifiers:(NSSet *)resourceIdentifiers
+                                     inBackingContext:(NSManagedObjectContext *)backingContext
 {
-    if (persistentStoreRequest.requestType == NSFetchRequestType) {
-        NSFetchRequest *fetchRequest = (NSFetchRequest *)persistentStoreRequest;
-        
-        NSURLRequest *request = [self.HTTPClient requestForFetchRequest:fetchRequest withContext:context];
-        if ([request URL]) {
-            AFHTTPRequestOperation *operation = [self.HTTPClient HTTPRequestOperationWithRequest:request success:^(AFHTTPRequestOperation *operation, id responseObject) {
-                id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
-                
-                NSArray *representations = nil;
-                if ([representationOrArrayOfRepresentations isKindOfClass:[NSArray class]]) {
-                    representations = representationOrArrayOfRepresentations;
-                } else {
-                    representations = [NSArray arrayWithObject:representationOrArrayOfRepresentations];
-                }
-                
-                NSManagedObjectContext *childContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
-                childContext.parentContext = context;
-                childContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
-                
-                [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification object:childContext queue:[NSOperationQueue mainQueue] usingBlock:^(NSNotification *note) {
-                    [context mergeChangesFromContextDidSaveNotification:note];
-                }];
-
-                NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
-                [childContext performBlock:^{
-                    NSEntityDescription *entity = fetchRequest.entity;
-                    for (NSDictionary *representation in representations) {
-                        NSString *resourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:representation ofEntity:entity fromResponse:operation.response];
-                        NSDictionary *attributes = [self.HTTPClient attributesForRepresentation:representation ofEntity:entity fromResponse:operation.response];
-                        NSDictionary *relationshipRepresentations = [self.HTTPClient representationsForRelationshipsFromRepresentation:representation ofEntity:entity fromResponse:operation.response];
-                        
-                        NSManagedObjectID *objectID = [self objectIDForBackingObjectForEntity:entity withResourceIdentifier:resourceIdentifier];
-                        
-                        NSManagedObject *backingObject = (objectID != nil) ? [backingContext existingObjectWithID:objectID error:nil] : [NSEntityDescription insertNewObjectForEntityForName:entity.name inManagedObjectContext:backingContext];
-                        [backingObject setValue:resourceIdentifier forKey:kAFIncrementalStoreResourceIdentifierAttributeName];
-                        [backingObject setValuesForKeysWithDictionary:attributes];
-                                                
-                        NSManagedObject *managedObject = [childContext existingObjectWithID:[self objectIDForEntity:entity withResourceIdentifier:resourceIdentifier] error:nil];
-                        [managedObject setValuesForKeysWithDictionary:attributes];
-                        if (objectID == nil) {
-                            [childContext insertObject:managedObject];
-                        }
-                        
-                        for (NSString *relationshipName in relationshipRepresentations) {
-                            id relationshipRepresentationOrArrayOfRepresentations = [relationshipRepresentations objectForKey:relationshipName];
-                            NSRelationshipDescription *relationship = [[entity relationshipsByName] valueForKey:relationshipName];
-                            
-                            if (relationship) {
-                                if ([relationship isToMany]) {
-                                    id mutableManagedRelationshipObjects = [relationship isOrdered] ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
-                                    id mutableBackingRelationshipObjects = [relationship isOrdered] ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
-                                    
-                                    for (NSDictionary *relationshipRepresentation in relationshipRepresentationOrArrayOfRepresentations) {
-                                        NSString *relationshipResourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:relationshipRepresentationOrArrayOfRepresentations ofEntity:relationship.entity fromResponse:operation.response];
-                                        NSDictionary *relationshipAttributes = [self.HTTPClient attributesForRepresentation:relationshipRepresentationOrArrayOfRepresentations ofEntity:relationship.destinationEntity fromResponse:operation.response];
-                                        
-                                        NSManagedObjectID *relationshipObjectID = [self objectIDForBackingObjectForEntity:relationship.destinationEntity withResourceIdentifier:relationshipResourceIdentifier];
-                                        
-                                        NSManagedObject *backingRelationshipObject = (relationshipObjectID != nil) ? [backingContext objectWithID:relationshipObjectID] : [NSEntityDescription insertNewObjectForEntityForName:relationship.destinationEntity.name inManagedObjectContext:backingContext];
-                                        [backingRelationshipObject setValue:relationshipResourceIdentifier forKey:kAFIncrementalStoreResourceIdentifierAttributeName];
-                                        [backingRelationshipObject setValuesForKeysWithDictionary:relationshipAttributes];
-                                        [mutableBackingRelationshipObjects addObject:backingRelationshipObject];
-                                        
-                                        NSManagedObject *managedRelationshipObject = [childContext existingObjectWithID:[self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:relationshipResourceIdentifier] error:nil];
-                                        [managedRelationshipObject setValuesForKeysWithDictionary:relationshipAttributes];
-                                        [mutableManagedRelationshipObjects addObject:managedRelationshipObject];
-                                        if (relationshipObjectID == nil) {
-                                            [childContext insertObject:managedRelationshipObject];
-                                        }
-                                    }
-                                    
-                                    [backingObject setValue:mutableBackingRelationshipObjects forKey:relationship.name];
-                                    [managedObject setValue:mutableManagedRelationshipObjects forKey:relationship.name];
-                                } else {
-                                    NSString *relationshipResourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:relationshipRepresentationOrArrayOfRepresentations ofEntity:relationship.destinationEntity fromResponse:operation.response];
-                                    NSDictionary *relationshipAttributes = [self.HTTPClient attributesForRepresentation:relationshipRepresentationOrArrayOfRepresentations ofEntity:relationship.destinationEntity fromResponse:operation.response];
-
-                                    NSManagedObjectID *relationshipObjectID = [self objectIDForBackingObjectForEntity:relationship.destinationEntity withResourceIdentifier:relationshipResourceIdentifier];
-
-                                    NSManagedObject *backingRelationshipObject = (relationshipObjectID != nil) ? [backingContext objectWithID:relationshipObjectID] : [NSEntityDescription insertNewObjectForEntityForName:relationship.destinationEntity.name inManagedObjectContext:backingContext];
-                                    [backingRelationshipObject setValue:relationshipResourceIdentifier forKey:kAFIncrementalStoreResourceIdentifierAttributeName];
-                                    [backingRelationshipObject setValuesForKeysWithDictionary:relationshipAttributes];
-                                    [backingObject setValue:backingRelationshipObject forKey:relationship.name];
-                                    
-                                    NSManagedObject *managedRelationshipObject = [childContext existingObjectWithID:[self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:relationshipResourceIdentifier] error:nil];
-                                    [managedRelationshipObject setValuesForKeysWithDictionary:relationshipAttributes];
-                                    [managedObject setValue:managedRelationshipObject forKey:relationship.name];
-                                    if (relationshipObjectID == nil) {
-                                        [childContext insertObject:managedRelationshipObject];
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    
-                    if (![backingContext save:error] || ![childContext save:error]) {
-                        NSLog(@"Error: %@", *error);
-                    }
-                }];
-            } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
-                NSLog(@"Error: %@", error);
-            }];
-            
-            operation.successCallbackQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0);
-            [self.HTTPClient enqueueHTTPRequestOperation:operation];
+    NSMutableDictionary *mutableObjectIDs = [NSMutableDictionary dictionaryWithCapacity:[resourceIdentifiers count]];
+    NSMutableSet *mutableUncachedResourceIdentifiers = [NSMutableSet setWithCapacity:[resourceIdentifiers count]];
+    for (NSString *resourceIdentifier in resourceIdentifiers) {
+        NSManagedObjectID *backingObjectID = [_backingObjectIDByObjectID objectForKey:[self objectIDForEntity:entity withResourceIdentifier:resourceIdentifier]];
+        if (backingObjectID) {
+            [mutableObjectIDs setObject:backingObjectID forKey:resourceIdentifier];
+        } else {
+            [mutableUncachedResourceIdentifiers addObject:resourceIdentifier];
+        }
+    }
+    
+    if ([mutableUncachedResourceIdentifiers count] == 0) {
+        return mutableObjectIDs;
+    }
+    
+    // Fetching full objects, rather than IDs, reads every row in a single round trip, so that the import calling `-existingObjectWithID:error:` right after finds them in the row cache of the coordinator. Only the object IDs are kept beyond that, in the bounded caches of backing object IDs, from which they are evicted past `cacheCountLimit` or on a memory warning
+    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:[entity name]];
+    fetchRequest.resultType = NSManagedObjectResultType;
+    fetchRequest.returnsObjectsAsFaults = NO;
+    fetchRequest.predicate = [NSPredicate predicateWithFormat:@"%K IN %@", kAFIncrementalStoreResourceIdentifierAttributeName, mutableUncachedResourceIdentifiers];
+    
+    [backingContext performBlockAndWait:^{
+        NSError *error = nil;
+        NSArray *results = [backingContext executeFetchRequest:fetchRequest error:&error];
+        if (error) {
+            [self didFailWithError:error];
+            return;
         }
         
-        NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
-        NSArray *results = nil;
-        
-        NSFetchRequestResultType resultType = fetchRequest.resultType;
-        switch (resultType) {
-            case NSManagedObjectResultType: {
-                fetchRequest = [fetchRequest copy];
-                fetchRequest.entity = [NSEntityDescription entityForName:fetchRequest.entityName inManagedObjectContext:backingContext];
-                fetchRequest.resultType = NSDictionaryResultType;
-                fetchRequest.propertiesToFetch = @[ kAFIncrementalStoreResourceIdentifierAttributeName ];
-                results = [backingContext executeFetchRequest:fetchRequest error:error];
-                NSMutableArray *mutableObjects = [NSMutableArray arrayWithCapacity:[results count]];
-                for (NSString *resourceIdentifier in [results valueForKeyPath:kAFIncrementalStoreResourceIdentifierAttributeName]) {
-                    NSManagedObjectID *objectID = [self objectIDForEntity:fetchRequest.entity withResourceIdentifier:resourceIdentifier];
-                    NSManagedObject *object = [context objectWithID:objectID];
-                    [mutableObjects addObject:object];
-                }
-                                
-                return mutableObjects;
-            }
-            case NSManagedObjectIDResultType:
-            case NSDictionaryResultType:
-            case NSCountResultType:
-                return [backingContext executeFetchRequest:fetchRequest error:error];
-            default:
-                goto _error;
+        for (NSManagedObject *backingObject in results) {
+            NSString *resourceIdentifier = [backingObject valueForKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+            [mutableObjectIDs setObject:backingObject.objectID forKey:resourceIdentifier];
+            [self cacheBackingObjectID:backingObject.objectID forEntity:entity withResourceIdentifier:resourceIdentifier];
         }
-    } else {
-        switch (persistentStoreRequest.requestType) {
-            case NSSaveRequestType:
-                return @[];
-            default:
-                goto _error;
+    }];
+    
+    return mutableObjectIDs;
+}
+
+- (void)cacheBackingObjectID:(NSManagedObjectID *)backingObjectID
+                   forEntity:(NSEntityDescription *)entity
+      withResourceIdentifier:(NSString *)resourceIdentifier
+{
+    // Temporary object IDs are only valid until the backing context is saved, after which they are replaced by the permanent IDs in `-backingManagedObjectContextDidSave:`
+    if (!backingObjectID || !resourceIdentifier || [backingObjectID isTemporaryID]) {
+        return;
+    }
+    
+    NSManagedObjectID *objectID = [self objectIDForEntity:entity withResourceIdentifier:resourceIdentifier];
+    [_backingObjectIDByObjectID setObject:backingObjectID forKey:objectID];
+    [_objectIDByBackingObjectID setObject:objectID forKey:backingObjectID];
+}
+
+- (void)cacheBackingObjectIDsOfBackingObjects:(id <NSFastEnumeration>)backingObjects {
+    NSDictionary *entitiesByName = [self.persistentStoreCoordinator.managedObjectModel entitiesByName];
+    for (NSManagedObject *backingObject in backingObjects) {
+        NSEntityDescription *entity = [entitiesByName objectForKey:backingObject.entity.name];
+        if (entity) {
+            [self cacheBackingObjectID:backingObject.objectID forEntity:entity withResourceIdentifier:[backingObject valueForKey:kAFIncrementalStoreResourceIdentifierAttributeName]];
+        }
+    }
+}
+
+- (NSArray *)objectIDsForBackingObjectIDs:(NSArray *)backingObjectIDs
+                                 ofEntity:(NSEntityDescription *)entity
+                                batchSize:(NSUInteger)batchSize
+                                    error:(NSError *__autoreleasing *)error
+{
+    NSMutableArray *mutableObjectIDs = [NSMutableArray arrayWithCapacity:[backingObjectIDs count]];
+    NSMutableDictionary *mutableIndexesByUncachedBackingObjectID = [NSMutableDictionary dictionary];
+    [backingObjectIDs enumerateObjectsUsingBlock:^(NSManagedObjectID *backingObjectID, NSUInteger idx, __unused BOOL *stop) {
+        NSManagedObjectID *objectID = [_objectIDByBackingObjectID objectForKey:backingObjectID];
+        if (objectID) {
+            [mutableObjectIDs addObject:objectID];
+        } else {
+            [mutableObjectIDs addObject:[NSNull null]];
+            [mutableIndexesByUncachedBackingObjectID setObject:[NSNumber numberWithUnsignedInteger:idx] forKey:backingObjectID];
         }
+    }];
+    
+    if ([mutableIndexesByUncachedBackingObjectID count] == 0) {
+        return mutableObjectIDs;
     }
     
-    return nil;
+    // Only backing objects missing from the cache have their resource identifiers read, a batch at a time, so that memory is bounded by the fetch batch size of the request
+    NSArray *uncachedBackingObjectIDs = [mutableIndexesByUncachedBackingObjectID allKeys];
+    NSUInteger numberOfUncachedBackingObjectIDs = [uncachedBackingObjectIDs count];
+    if (batchSize == 0) {
+        batchSize = numberOfUncachedBackingObjectIDs;
+    }
     
-    _error: {
-        NSMutableDictionary *mutableUserInfo = [NSMutableDictionary dictionary];
-        [mutableUserInfo setValue:[NSString stringWithFormat:NSLocalizedString(@"Unsupported NSFetchRequestResultType, %d", nil), persistentStoreRequest.requestType] forKey:NSLocalizedDescriptionKey];
-        if (error) {
-            *error = [[NSError alloc] initWithDomain:AFNetworkingErrorDomain code:0 userInfo:mutableUserInfo];
+    NSDictionary *entitiesByName = [self.persistentStoreCoordinator.managedObjectModel entitiesByName];
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    __block NSError *fetchError = nil;
+    for (NSUInteger location = 0; location < numberOfUncachedBackingObjectIDs && !fetchError; location += batchSize) {
+        @autoreleasepool {
+            NSArray *batchOfBackingObjectIDs = [uncachedBackingObjectIDs subarrayWithRange:NSMakeRange(location, MIN(batchSize, numberOfUncachedBackingObjectIDs - location))];
+            NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:[entity name]];
+            fetchRequest.returnsObjectsAsFaults = NO;
+            fetchRequest.predicate = [NSPredicate predicateWithFormat:@"SELF IN %@", batchOfBackingObjectIDs];
+            [backingContext performBlockAndWait:^{
+                NSArray *results = [backingContext executeFetchRequest:fetchRequest error:&fetchError];
+                for (NSManagedObject *backingObject in results) {
+                    NSString *resourceIdentifier = [backingObject valueForKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+                    NSEntityDescription *backingObjectEntity = [entitiesByName objectForKey:backingObject.entity.name];
+                    NSManagedObjectID *objectID = [self objectIDForEntity:backingObjectEntity withResourceIdentifier:resourceIdentifier];
+                    [mutableObjectIDs replaceObjectAtIndex:[[mutableIndexesByUncachedBackingObjectID objectForKey:backingObject.objectID] unsignedIntegerValue] withObject:objectID];
+                    [self cacheBackingObjectID:backingObject.objectID forEntity:backingObjectEntity withResourceIdentifier:resourceIdentifier];
+                }
+            }];
         }
+    }
     
+    if (fetchError) {
+        if (error) {
+            *error = fetchError;
+        }
+        
         return nil;
     }
+    
+    // Backing objects deleted since they were fetched by ID have no frontend counterpart
+    [mutableObjectIDs removeObjectIdenticalTo:[NSNull null]];
+    
+    return mutableObjectIDs;
 }
 
-#pragma mark -
-
-- (NSIncrementalStoreNode *)newValuesForObjectWithID:(NSManagedObjectID *)objectID
-                                         withContext:(NSManagedObjectContext *)context
-                                               error:(NSError *__autoreleasing *)error
-{
-    NSFetchRequest *fetchRequest = [[NSFetchRequest alloc] initWithEntityName:[[objectID entity] name]];
-    fetchRequest.resultType = NSDictionaryResultType;
-    fetchRequest.fetchLimit = 1;
-    fetchRequest.includesSubentities = NO;
-    fetchRequest.propertiesToFetch = [[[NSEntityDescription entityForName:fetchRequest.entityName inManagedObjectContext:context] attributesByName] allKeys];
-    fetchRequest.predicate = [NSPredicate predicateWithFormat:@"%K = %@", kAFIncrementalStoreResourceIdentifierAttributeName, [self referenceObjectForObjectID:objectID]];
+- (void)backingManagedObjectContextWillSave:(NSNotification *)notification {
+    // Deleted objects are evicted before the save, while their resource identifiers can still be read
+    NSManagedObjectContext *backingContext = [notification object];
+    NSDictionary *entitiesByName = [self.persistentStoreCoordinator.managedObjectModel entitiesByName];
+    for (NSManagedObject *backingObject in [backingContext deletedObjects]) {
+        NSString *resourceIdentifier = [backingObject valueForKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+        NSEntityDescription *entity = [entitiesByName objectForKey:backingObject.entity.name];
+        if (resourceIdentifier && entity) {
+            [_backingObjectIDByObjectID removeObjectForKey:[self objectIDForEntity:entity withResourceIdentifier:resourceIdentifier]];
+            [_objectIDByBackingObjectID removeObjectForKey:backingObject.objectID];
+        }
+    }
     
-    NSArray *results = [[self backingManagedObjectContext] executeFetchRequest:fetchRequest error:error];
-    NSDictionary *attributeValues = [results lastObject] ?: [NSDictionary dictionary];
+    // Refreshing only the last fetched date of an object does not change any of its values, and so does not change its version
+    for (NSManagedObject *backingObject in [backingContext updatedObjects]) {
+        NSDictionary *changedValues = [backingObject changedValues];
+        BOOL isRefreshedOnly = [changedValues count] == 1 && [changedValues objectForKey:kAFIncrementalStoreLastFetchedDateAttributeName];
+        if ([backingObject hasChanges] && !isRefreshedOnly && ![changedValues objectForKey:kAFIncrementalStoreVersionAttributeName]) {
+            [backingObject setValue:[NSNumber numberWithLongLong:[[backingObject valueForKey:kAFIncrementalStoreVersionAttributeName] longLongValue] + 1] forKey:kAFIncrementalStoreVersionAttributeName];
+        }
+    }
+}
 
-    NSIncrementalStoreNode *node = [[NSIncrementalStoreNode alloc] initWithObjectID:objectID withValues:attributeValues version:1];
+- (void)backingManagedObjectContextDidSave:(NSNotification *)notification {
+    // Saves of import contexts are merged into the shared backing context before the imported objects are merged into the frontend, so that faults fulfilled from it see the imported values
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    NSMutableArray *mutableChangedBackingObjectIDs = [NSMutableArray array];
+    [mutableChangedBackingObjectIDs addObjectsFromArray:[[[[notification userInfo] objectForKey:NSUpdatedObjectsKey] valueForKey:@"objectID"] allObjects]];
+    [mutableChangedBackingObjectIDs addObjectsFromArray:[[[[notification userInfo] objectForKey:NSDeletedObjectsKey] valueForKey:@"objectID"] allObjects]];
     
-    if ([self.HTTPClient respondsToSelector:@selector(shouldFetchRemoteAttributeValuesForObjectWithID:inManagedObjectContext:)] && [self.HTTPClient shouldFetchRemoteAttributeValuesForObjectWithID:objectID inManagedObjectContext:context]) {
-        if (attributeValues) {
-            NSManagedObjectContext *backingManagedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
-            backingManagedObjectContext.parentContext = context;
-            backingManagedObjectContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
-            
-            NSURLRequest *request = [self.HTTPClient requestWithMethod:@"GET" pathForObjectWithID:objectID withContext:context];
-            
-            if ([request URL]) {
-                AFHTTPRequestOperation *operation = [self.HTTPClient HTTPRequestOperationWithRequest:request success:^(AFHTTPRequestOperation *operation, NSDictionary *representation) {
-                    NSManagedObject *managedObject = [backingManagedObjectContext existingObjectWithID:objectID error:error];
-                    
-                    NSMutableDictionary *mutablePropertyValues = [attributeValues mutableCopy];
-                    [mutablePropertyValues addEntriesFromDictionary:[self.HTTPClient attributesForRepresentation:representation ofEntity:managedObject.entity fromResponse:operation.response]];
-                    [managedObject setValuesForKeysWithDictionary:mutablePropertyValues];
-                    
-                    if (![backingManagedObjectContext save:error]) {
-                        NSLog(@"Error: %@", *error);
-                    }
-                } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
-                    NSLog(@"Error: %@, %@", operation, error);
-                }];
-                
-                [self.HTTPClient enqueueHTTPRequestOperation:operation];
-            }
+    // Cached rows and relationships are only read and written on the queue of the shared backing context, and are evicted there along with the merge, so that no values read before the merge are cached after it
+    void (^evictCachedValues)(void) = ^{
+        for (NSManagedObjectID *backingObjectID in mutableChangedBackingObjectIDs) {
+            [_propertyValuesCache removeObjectForKey:backingObjectID];
+            [_relationshipsCache removeObjectForKey:backingObjectID];
         }
+    };
+    
+    if ([notification object] != backingContext) {
+        [backingContext performBlockAndWait:^{
+            [backingContext mergeChangesFromContextDidSaveNotification:notification];
+            evictCachedValues();
+        }];
+    } else {
+        evictCachedValues();
     }
     
-    return node;
+    NSMutableSet *mutableBackingObjects = [NSMutableSet set];
+    [mutableBackingObjects unionSet:[[notification userInfo] objectForKey:NSInsertedObjectsKey]];
+    [mutableBackingObjects unionSet:[[notification userInfo] objectForKey:NSUpdatedObjectsKey]];
+    [self cacheBackingObjectIDsOfBackingObjects:mutableBackingObjects];
 }
 
-- (id)newValueForRelationship:(NSRelationshipDescription *)relationship
-              forObjectWithID:(NSManagedObjectID *)objectID
-                  withContext:(NSManagedObjectContext *)context
-                        error:(NSError *__autoreleasing *)error
+- (NSDictionary *)resourceIdentifiersByEntityNameForRepresentations:(NSArray *)representations
+                                                           ofEntity:(NSEntityDescription *)entity
+                                                       fromResponse:(NSHTTPURLResponse *)response
+{
+    NSMutableDictionary *mutableResourceIdentifiersByEntityName = [NSMutableDictionary dictionary];
+    NSString * (^addResourceIdentifierForRepresentation)(NSDictionary *, NSEntityDescription *) = ^NSString *(NSDictionary *representation, NSEntityDescription *representationEntity) {
+        NSString *resourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:representation ofEntity:representationEntity fromResponse:response];
+        if (!resourceIdentifier) {
+            return nil;
+        }
+        
+        NSMutableSet *mutableResourceIdentifiers = [mutableResourceIdentifiersByEntityName objectForKey:representationEntity.name];
+        if (!mutableResourceIdentifiers) {
+            mutableResourceIdentifiers = [NSMutableSet set];
+            [mutableResourceIdentifiersByEntityName setObject:mutableResourceIdentifiers forKey:representationEntity.name];
+        }
+        [mutableResourceIdentifiers addObject:resourceIdentifier];
+        
+        return resourceIdentifier;
+    };
+    
+    // Embedded representations are visited as deep as they are imported, and each resource is only descended into once, so that cyclic graphs returned by the HTTP client terminate
+    NSMutableSet *mutableVisitedResourceKeys = [NSMutableSet set];
+    __block __weak void (^weakAddResourceIdentifiersForRelationshipsOfRepresentation)(NSDictionary *, NSEntityDescription *, NSUInteger);
+    void (^addResourceIdentifiersForRelationshipsOfRepresentation)(NSDictionary *, NSEntityDescription *, NSUInteger) = ^(NSDictionary *representation, NSEntityDescription *representationEntity, NSUInteger depth) {
+        if (self.maximumRelationshipImportDepth > 0 && depth >= self.maximumRelationshipImportDepth) {
+            return;
+        }
+        
+        AFEntityMapping *mapping = [self mappingForEntity:representationEntity];
+        NSDictionary *relationshipRepresentations = [self.HTTPClient representationsForRelationshipsFromRepresentation:representation ofEntity:representationEntity fromResponse:response];
+        for (NSString *relationshipName in relationshipRepresentations) {
+            NSEntityDescription *destinationEntity = [mapping.destinationEntitiesByRelationshipName objectForKey:relationshipName];
+            if (!destinationEntity) {
+                continue;
+            }
+            
+            id relationshipRepresentationOrArrayOfRepresentations = [relationshipRepresentations objectForKey:relationshipName];
+            NSArray *relationshipRepresentationsForName = [relationshipRepresentationOrArrayOfRepresentations isKindOfClass:[NSArray class]] ? relationshipRepresentationOrArrayOfRepresentations : [NSArray arrayWithObject:relationshipRepresentationOrArrayOfRepresentations];
+            for (NSDictionary *relationshipRepresentation in relationshipRepresentationsForName) {
+                NSString *resourceIdentifier = addResourceIdentifierForRepresentation(relationshipRepresentation, destinationEntity);
+                NSString *resourceKey = resourceIdentifier ? [destinationEntity.name stringByAppendingFormat:@" %@", resourceIdentifier] : nil;
+                if (resourceKey && ![mutableVisitedResourceKeys containsObject:resourceKey]) {
+                    [mutableVisitedResourceKeys addObject:resourceKey];
+                    weakAddResourceIdentifiersForRelationshipsOfRepresentation(relationshipRepresentation, destinationEntity, depth + 1);
+                }
+            }
+        }
+    };
+    weakAddResourceIdentifiersForRelationshipsOfRepresentation = addResourceIdentifiersForRelationshipsOfRepresentation;
+    
+    for (NSDictionary *representation in representations) {
+        NSString *resourceIdentifier = addResourceIdentifierForRepresentation(representation, entity);
+        if (resourceIdentifier) {
+            [mutableVisitedResourceKeys addObject:[entity.name stringByAppendingFormat:@" %@", resourceIdentifier]];
+            addResourceIdentifiersForRelationshipsOfRepresentation(representation, entity, 0);
+        }
+    }
+    
+    return mutableResourceIdentifiersByEntityName;
+}
+
+- (AFHTTPRequestOperation *)enqueueHTTPRequestOperationWithRequest:(NSURLRequest *)request
+                                                           success:(void (^)(AFHTTPRequestOperation *operation, id responseObject))success
+                                                           failure:(void (^)(AFHTTPRequestOperation *operation, NSError *error))failure
+{
+    return [self enqueueHTTPRequestOperationWithRequest:request queuePriority:NSOperationQueuePriorityNormal forFaultsOfObjectsWithIDs:nil success:success failure:failure];
+}
+
+- (AFHTTPRequestOperation *)enqueueHTTPRequestOperationWithRequest:(NSURLRequest *)request
+                                                     queuePriority:(NSOperationQueuePriority)queuePriority
+                                       forFaultsOfObjectsWithIDs:(NSArray *)objectIDs
+                                                           success:(void (^)(AFHTTPRequestOperation *operation, id responseObject))success
+                                                           failure:(void (^)(AFHTTPRequestOperation *operation, NSError *error))failure
+{
+    void (^successCallback)(AFHTTPRequestOperation *, id) = success ? [success copy] : [^(AFHTTPRequestOperation *operation, id responseObject) {} copy];
+    void (^failureCallback)(AFHTTPRequestOperation *, NSError *) = failure ? [failure copy] : [^(AFHTTPRequestOperation *operation, NSError *error) {} copy];
+    
+    if (!AFRequestIsCoalescable(request)) {
+        AFHTTPRequestOperation *operation = [self.HTTPClient HTTPRequestOperationWithRequest:request success:successCallback failure:failureCallback];
+        operation.successCallbackQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0);
+        operation.queuePriority = queuePriority;
+        [self.HTTPClient enqueueHTTPRequestOperation:operation];
+        
+        return operation;
+    }
+    
+    // Callers requesting a resource that is already being loaded are attached to the operation in flight, and share its response
+    NSString *requestSignature = AFRequestSignature(request);
+    __block BOOL isInFlight = NO;
+    __block AFHTTPRequestOperation *inFlightOperation = nil;
+    dispatch_sync(_requestCoalescingQueue, ^{
+        NSMutableArray *mutableCallbacks = [_callbacksByRequestSignature objectForKey:requestSignature];
+        NSMutableSet *mutableFaultObjectIDs = [_faultObjectIDsByRequestSignature objectForKey:requestSignature];
+        if (mutableCallbacks) {
+            isInFlight = YES;
+            inFlightOperation = [_HTTPRequestOperationsByRequestSignature objectForKey:requestSignature];
+        } else {
+            mutableCallbacks = [NSMutableArray array];
+            [_callbacksByRequestSignature setObject:mutableCallbacks forKey:requestSignature];
+            
+            if (objectIDs) {
+                mutableFaultObjectIDs = [NSMutableSet set];
+                [_faultObjectIDsByRequestSignature setObject:mutableFaultObjectIDs forKey:requestSignature];
+            }
+        }
+        
+        [mutableCallbacks addObject:[NSArray arrayWithObjects:successCallback, failureCallback, nil]];
+        
+        // A request is only cancellable for as long as every caller attached to it is a fault
+        if (objectIDs && mutableFaultObjectIDs) {
+            [mutableFaultObjectIDs addObjectsFromArray:objectIDs];
+            for (NSManagedObjectID *objectID in objectIDs) {
+                NSMutableSet *mutableRequestSignatures = [_faultRequestSignaturesByObjectID objectForKey:objectID];
+                if (!mutableRequestSignatures) {
+                    mutableRequestSignatures = [NSMutableSet set];
+                    [_faultRequestSignaturesByObjectID setObject:mutableRequestSignatures forKey:objectID];
+                }
+                [mutableRequestSignatures addObject:requestSignature];
+            }
+        } else if (!objectIDs) {
+            [_faultObjectIDsByRequestSignature removeObjectForKey:requestSignature];
+        }
+    });
+    
+    if (isInFlight) {
+        if (queuePriority > [inFlightOperation queuePriority] && ![inFlightOperation isExecuting]) {
+            [inFlightOperation setQueuePriority:queuePriority];
+        }
+        
+        return inFlightOperation;
+    }
+    
+    NSArray * (^dequeueCallbacks)(void) = ^NSArray *{
+        __block NSArray *callbacks = nil;
+        dispatch_sync(_requestCoalescingQueue, ^{
+            callbacks = [_callbacksByRequestSignature objectForKey:requestSignature];
+            [_callbacksByRequestSignature removeObjectForKey:requestSignature];
+            [_HTTPRequestOperationsByRequestSignature removeObjectForKey:requestSignature];
+            
+            for (NSManagedObjectID *objectID in [_faultObjectIDsByRequestSignature objectForKey:requestSignature]) {
+                NSMutableSet *mutableRequestSignatures = [_faultRequestSignaturesByObjectID objectForKey:objectID];
+                [mutableRequestSignatures removeObject:requestSignature];
+                if ([mutableRequestSignatures count] == 0) {
+                    [_faultRequestSignaturesByObjectID removeObjectForKey:objectID];
+                }
+            }
+            [_faultObjectIDsByRequestSignature removeObjectForKey:requestSignature];
+        });
+        
+        return callbacks;
+    };
+    
+    AFHTTPRequestOperation *operation = [self.HTTPClient HTTPRequestOperationWithRequest:request success:^(AFHTTPRequestOperation *operation, id responseObject) {
+        for (NSArray *callbacks in dequeueCallbacks()) {
+            void (^callback)(AFHTTPRequestOperation *, id) = [callbacks objectAtIndex:0];
+            callback(operation, responseObject);
+        }
+    } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+        for (NSArray *callbacks in dequeueCallbacks()) {
+            void (^callback)(AFHTTPRequestOperation *, NSError *) = [callbacks objectAtIndex:1];
+            callback(operation, error);
+        }
+    }];
+    operation.successCallbackQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0);
+    operation.queuePriority = queuePriority;
+    
+    dispatch_sync(_requestCoalescingQueue, ^{
+        [_HTTPRequestOperationsByRequestSignature setObject:operation forKey:requestSignature];
+    });
+    
+    [self.HTTPClient enqueueHTTPRequestOperation:operation];
+    
+    return operation;
+}
+
+- (NSURLRequest *)conditionalRequestForRequest:(NSURLRequest *)request {
+    NSDictionary *validators = [[self metadataValueForKey:kAFIncrementalStoreHTTPValidatorsMetadataKey] valueForKey:AFRequestSignature(request)];
+    if (!validators) {
+        return request;
+    }
+    
+    // The local cache is bypassed, so that the server, rather than the URL loading system, decides whether the backing store is up to date
+    NSMutableURLRequest *mutableRequest = [request mutableCopy];
+    mutableRequest.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    
+    NSString *entityTag = [validators valueForKey:@"ETag"];
+    if (entityTag && ![mutableRequest valueForHTTPHeaderField:@"If-None-Match"]) {
+        [mutableRequest setValue:entityTag forHTTPHeaderField:@"If-None-Match"];
+    }
+    
+    NSString *lastModified = [validators valueForKey:@"Last-Modified"];
+    if (lastModified && ![mutableRequest valueForHTTPHeaderField:@"If-Modified-Since"]) {
+        [mutableRequest setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+    }
+    
+    return mutableRequest;
+}
+
+- (void)setHTTPValidatorsForRequest:(NSURLRequest *)request
+                       fromResponse:(NSHTTPURLResponse *)response
+{
+    NSDictionary *headers = [response allHeaderFields];
+    NSMutableDictionary *mutableValidators = [NSMutableDictionary dictionaryWithCapacity:2];
+    [mutableValidators setValue:[headers valueForKey:@"ETag"] forKey:@"ETag"];
+    [mutableValidators setValue:[headers valueForKey:@"Last-Modified"] forKey:@"Last-Modified"];
+    
+    NSString *requestSignature = AFRequestSignature(request);
+    [self updateMetadataValueForKey:kAFIncrementalStoreHTTPValidatorsMetadataKey usingBlock:^id(NSDictionary *validatorsByRequestSignature) {
+        NSDictionary *previousValidators = [validatorsByRequestSignature valueForKey:requestSignature];
+        if ([previousValidators isEqualToDictionary:mutableValidators] || ([mutableValidators count] == 0 && !previousValidators)) {
+            return validatorsByRequestSignature;
+        }
+        
+        NSMutableDictionary *mutableValidatorsByRequestSignature = [validatorsByRequestSignature mutableCopy] ?: [NSMutableDictionary dictionary];
+        [mutableValidatorsByRequestSignature setValue:([mutableValidators count] > 0 ? mutableValidators : nil) forKey:requestSignature];
+        
+        return mutableValidatorsByRequestSignature;
+    }];
+}
+
+- (BOOL)removeHTTPValidatorsForRequest:(NSURLRequest *)request {
+    NSString *requestSignature = AFRequestSignature(request);
+    __block BOOL didRemoveValidators = NO;
+    [self updateMetadataValueForKey:kAFIncrementalStoreHTTPValidatorsMetadataKey usingBlock:^id(NSDictionary *validatorsByRequestSignature) {
+        if (![validatorsByRequestSignature valueForKey:requestSignature]) {
+            return validatorsByRequestSignature;
+        }
+        
+        NSMutableDictionary *mutableValidatorsByRequestSignature = [validatorsByRequestSignature mutableCopy];
+        [mutableValidatorsByRequestSignature removeObjectForKey:requestSignature];
+        didRemoveValidators = YES;
+        
+        return mutableValidatorsByRequestSignature;
+    }];
+    
+    return didRemoveValidators;
+}
+
+- (NSDate *)lastFetchedDateForKey:(NSString *)key
+                         ofEntity:(NSEntityDescription *)entity
+{
+    return [[[self metadataValueForKey:kAFIncrementalStoreLastFetchedDatesMetadataKey] objectForKey:entity.name] objectForKey:key];
+}
+
+- (void)setLastFetchedDateForKey:(NSString *)key
+                        ofEntity:(NSEntityDescription *)entity
+{
+    if (![self.HTTPClient respondsToSelector:@selector(timeToLiveForEntity:)]) {
+        return;
+    }
+    
+    NSDate *now = [NSDate date];
+    NSTimeInterval timeToLive = [self.HTTPClient timeToLiveForEntity:entity];
+    [self updateMetadataValueForKey:kAFIncrementalStoreLastFetchedDatesMetadataKey usingBlock:^id(NSDictionary *lastFetchedDatesByEntityName) {
+        // Dates past the time to live of their entity are pruned whenever another is stored, so that dates stamped for every relationship fault do not accumulate in the metadata
+        NSMutableDictionary *mutableLastFetchedDatesByKey = [NSMutableDictionary dictionaryWithObject:now forKey:key];
+        [[lastFetchedDatesByEntityName objectForKey:entity.name] enumerateKeysAndObjectsUsingBlock:^(id otherKey, NSDate *lastFetchedDate, __unused BOOL *stop) {
+            NSTimeInterval age = [now timeIntervalSinceDate:lastFetchedDate];
+            if (![otherKey isEqual:key] && age >= 0 && age < timeToLive) {
+                [mutableLastFetchedDatesByKey setObject:lastFetchedDate forKey:otherKey];
+            }
+        }];
+        
+        NSMutableDictionary *mutableLastFetchedDatesByEntityName = [lastFetchedDatesByEntityName mutableCopy] ?: [NSMutableDictionary dictionary];
+        [mutableLastFetchedDatesByEntityName setObject:mutableLastFetchedDatesByKey forKey:entity.name];
+        
+        return mutableLastFetchedDatesByEntityName;
+    }];
+}
+
+- (BOOL)isFreshLastFetchedDate:(NSDate *)lastFetchedDate
+                     forEntity:(NSEntityDescription *)entity
+{
+    if (!lastFetchedDate || ![self.HTTPClient respondsToSelector:@selector(timeToLiveForEntity:)]) {
+        return NO;
+    }
+    
+    NSTimeInterval timeToLive = [self.HTTPClient timeToLiveForEntity:entity];
+    NSTimeInterval age = [[NSDate date] timeIntervalSinceDate:lastFetchedDate];
+    
+    return timeToLive > 0 && age >= 0 && age < timeToLive;
+}
+
+- (void)importRepresentations:(NSArray *)representations
+                     ofEntity:(NSEntityDescription *)entity
+                 fromResponse:(NSHTTPURLResponse *)response
+                  withContext:(NSManagedObjectContext *)context
+{
+    [self importRepresentations:representations ofEntity:entity deletedResourceIdentifiers:nil forRelationship:nil ofObjectWithID:nil fromResponse:response withContext:context completion:nil];
+}
+
+- (void)importRepresentations:(NSArray *)representations
+                     ofEntity:(NSEntityDescription *)entity
+   deletedResourceIdentifiers:(NSArray *)deletedResourceIdentifiers
+              forRelationship:(NSRelationshipDescription *)relationship
+               ofObjectWithID:(NSManagedObjectID *)objectID
+                 fromResponse:(NSHTTPURLResponse *)response
+                  withContext:(NSManagedObjectContext *)context
+                   completion:(void (^)(BOOL didImportAllBatches))completion
+{
+    NSManagedObjectContext *childContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    childContext.parentContext = context;
+    childContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
+    [childContext.userInfo setObject:[NSNumber numberWithBool:YES] forKey:kAFIncrementalStoreImportContextKey];
+    
+    // Imported objects are only stamped when the HTTP client has a time to live to compare the stamp against, as doing so writes every imported object to the backing store
+    NSDate *lastFetchedDate = [self.HTTPClient respondsToSelector:@selector(timeToLiveForEntity:)] ? [NSDate date] : nil;
+
+    // Each import maps into, and saves, its own backing context on the shared coordinator, so that imports run in parallel up to the number of active processors. Imports that may write the same entities are run in the order they were scheduled, so that neither inserts a duplicate of a resource the other is inserting
+    NSManagedObjectContext *backingContext = [self newImportBackingManagedObjectContext];
+    NSBlockOperation *importOperation = [NSBlockOperation blockOperationWithBlock:^{
+        [childContext performBlockAndWait:^{
+            // Representations are imported and saved in batches, each within its own autorelease pool, so that peak memory is bounded by the batch size rather than by the size of the response
+            NSUInteger numberOfRepresentations = [representations count];
+            NSUInteger batchSize = MAX((self.importBatchSize > 0) ? self.importBatchSize : numberOfRepresentations, (NSUInteger)1);
+            BOOL didImportAllBatches = YES;
+            
+            // The objects imported for a relationship are kept across batches, as faults, until the relationship is set
+            id mutableRelationshipBackingObjects = [relationship isOrdered] ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
+            id mutableRelationshipManagedObjects = [relationship isOrdered] ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
+            for (NSUInteger location = 0; location == 0 || location < numberOfRepresentations; location += batchSize) {
+                @autoreleasepool {
+                    CFAbsoluteTime importStartTime = CFAbsoluteTimeGetCurrent();
+                    NSArray *batchOfRepresentations = [representations subarrayWithRange:NSMakeRange(location, MIN(batchSize, numberOfRepresentations - location))];
+                    
+                    // Resolve every resource identifier in the batch up front, with a single fetch per entity, rather than a fetch per representation
+                    NSMutableDictionary *mutableBackingObjectIDsByEntityName = [NSMutableDictionary dictionary];
+                    NSDictionary *resourceIdentifiersByEntityName = [self resourceIdentifiersByEntityNameForRepresentations:batchOfRepresentations ofEntity:entity fromResponse:response];
+                    for (NSString *entityName in resourceIdentifiersByEntityName) {
+                        NSEntityDescription *representationEntity = [NSEntityDescription entityForName:entityName inManagedObjectContext:childContext];
+                        NSDictionary *objectIDs = [self objectIDsForBackingObjectsForEntity:representationEntity withResourceIdentifiers:[resourceIdentifiersByEntityName objectForKey:entityName] inBackingContext:backingContext];
+                        [mutableBackingObjectIDsByEntityName setObject:[objectIDs mutableCopy] forKey:entityName];
+                    }
+                    
+                    NSManagedObjectID * (^backingObjectIDForResourceIdentifier)(NSString *, NSEntityDescription *) = ^NSManagedObjectID *(NSString *resourceIdentifier, NSEntityDescription *representationEntity) {
+                        return resourceIdentifier ? [[mutableBackingObjectIDsByEntityName objectForKey:representationEntity.name] objectForKey:resourceIdentifier] : nil;
+                    };
+                    
+                    // Objects inserted earlier in the same response are recorded, so that repeated representations update rather than duplicate them
+                    void (^setBackingObjectIDForResourceIdentifier)(NSManagedObjectID *, NSString *, NSEntityDescription *) = ^(NSManagedObjectID *backingObjectID, NSString *resourceIdentifier, NSEntityDescription *representationEntity) {
+                        if (!resourceIdentifier) {
+                            return;
+                        }
+                        
+                        NSMutableDictionary *mutableObjectIDs = [mutableBackingObjectIDsByEntityName objectForKey:representationEntity.name];
+                        if (!mutableObjectIDs) {
+                            mutableObjectIDs = [NSMutableDictionary dictionary];
+                            [mutableBackingObjectIDsByEntityName setObject:mutableObjectIDs forKey:representationEntity.name];
+                        }
+                        [mutableObjectIDs setObject:backingObjectID forKey:resourceIdentifier];
+                    };
+                    
+                    // Backing objects may only be touched on the queue of the backing context
+                    NSManagedObject * (^backingObjectForRepresentation)(NSString *, NSDictionary *, NSEntityDescription *, BOOL *) = ^NSManagedObject *(NSString *resourceIdentifier, NSDictionary *attributes, NSEntityDescription *representationEntity, BOOL *isNew) {
+                        __block NSManagedObject *backingObject = nil;
+                        [backingContext performBlockAndWait:^{
+                            NSManagedObjectID *backingObjectID = backingObjectIDForResourceIdentifier(resourceIdentifier, representationEntity);
+                            *isNew = (backingObjectID == nil);
+                            
+                            backingObject = (backingObjectID != nil) ? [backingContext existingObjectWithID:backingObjectID error:nil] : [NSEntityDescription insertNewObjectForEntityForName:representationEntity.name inManagedObjectContext:backingContext];
+                            AFSetChangedValueForKey(backingObject, resourceIdentifier, kAFIncrementalStoreResourceIdentifierAttributeName);
+                            setBackingObjectIDForResourceIdentifier(backingObject.objectID, resourceIdentifier, representationEntity);
+                            AFSetChangedValuesForKeysWithDictionary(backingObject, attributes);
+                            if (lastFetchedDate) {
+                                AFSetChangedValueForKey(backingObject, lastFetchedDate, kAFIncrementalStoreLastFetchedDateAttributeName);
+                            }
+                        }];
+                        
+                        return backingObject;
+                    };
+                    
+                    // Objects are materialized once per batch for each resource, so that a resource embedded in many representations, such as the author of every tweet in a timeline, is only mapped again if its representation differs
+                    NSMutableDictionary *mutableImportedObjectsByResourceIdentifierByEntityName = [NSMutableDictionary dictionary];
+                    NSManagedObject * (^managedObjectForRepresentation)(NSDictionary *, NSEntityDescription *, NSManagedObject **) = ^NSManagedObject *(NSDictionary *representation, NSEntityDescription *representationEntity, NSManagedObject **backingObject) {
+                        NSString *resourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:representation ofEntity:representationEntity fromResponse:response];
+                        if (!resourceIdentifier) {
+                            return nil;
+                        }
+                        
+                        NSMutableDictionary *mutableImportedObjectsByResourceIdentifier = [mutableImportedObjectsByResourceIdentifierByEntityName objectForKey:representationEntity.name];
+                        if (!mutableImportedObjectsByResourceIdentifier) {
+                            mutableImportedObjectsByResourceIdentifier = [NSMutableDictionary dictionary];
+                            [mutableImportedObjectsByResourceIdentifierByEntityName setObject:mutableImportedObjectsByResourceIdentifier forKey:representationEntity.name];
+                        }
+                        
+                        NSArray *importedObjects = [mutableImportedObjectsByResourceIdentifier objectForKey:resourceIdentifier];
+                        if ([[importedObjects objectAtIndex:0] isEqualToDictionary:representation]) {
+                            *backingObject = [importedObjects objectAtIndex:1];
+                            return [importedObjects objectAtIndex:2];
+                        }
+                        
+                        NSDictionary *attributes = [self.HTTPClient attributesForRepresentation:representation ofEntity:representationEntity fromResponse:response];
+                        
+                        BOOL isNewObject = NO;
+                        *backingObject = backingObjectForRepresentation(resourceIdentifier, attributes, representationEntity, &isNewObject);
+                        
+                        NSManagedObject *managedObject = [childContext existingObjectWithID:[self objectIDForEntity:representationEntity withResourceIdentifier:resourceIdentifier] error:nil];
+                        AFSetChangedValuesForKeysWithDictionary(managedObject, attributes);
+                        if (isNewObject) {
+                            [childContext insertObject:managedObject];
+                        }
+                        
+                        if (*backingObject && managedObject) {
+                            [mutableImportedObjectsByResourceIdentifier setObject:[NSArray arrayWithObjects:representation, *backingObject, managedObject, nil] forKey:resourceIdentifier];
+                        }
+                        
+                        return managedObject;
+                    };
+                    
+                    // Relationships are imported recursively down to `maximumRelationshipImportDepth`. An object is not descended into while its own relationships are being imported further up the graph, or if the same representation was already descended into from as shallow a level, so that cyclic graphs terminate and shared subgraphs are imported once
+                    NSMutableSet *mutableObjectIDsBeingImported = [NSMutableSet set];
+                    NSMutableDictionary *mutableImportedRelationshipsByObjectID = [NSMutableDictionary dictionary];
+                    __block __weak void (^weakImportRelationshipsOfRepresentation)(NSDictionary *, NSEntityDescription *, NSManagedObject *, NSManagedObject *, NSUInteger);
+                    void (^importRelationshipsOfRepresentation)(NSDictionary *, NSEntityDescription *, NSManagedObject *, NSManagedObject *, NSUInteger) = ^(NSDictionary *representation, NSEntityDescription *representationEntity, NSManagedObject *backingObject, NSManagedObject *managedObject, NSUInteger depth) {
+                        if (self.maximumRelationshipImportDepth > 0 && depth >= self.maximumRelationshipImportDepth) {
+                            return;
+                        }
+                        
+                        NSManagedObjectID *objectID = managedObject.objectID;
+                        NSArray *importedRelationships = [mutableImportedRelationshipsByObjectID objectForKey:objectID];
+                        if ([mutableObjectIDsBeingImported containsObject:objectID] || ([[importedRelationships objectAtIndex:1] unsignedIntegerValue] <= depth && [[importedRelationships objectAtIndex:0] isEqualToDictionary:representation])) {
+                            return;
+                        }
+                        
+                        [mutableImportedRelationshipsByObjectID setObject:[NSArray arrayWithObjects:representation, [NSNumber numberWithUnsignedInteger:depth], nil] forKey:objectID];
+                        [mutableObjectIDsBeingImported addObject:objectID];
+                        
+                        AFEntityMapping *representationMapping = [self mappingForEntity:representationEntity];
+                        NSDictionary *relationshipRepresentations = [self.HTTPClient representationsForRelationshipsFromRepresentation:representation ofEntity:representationEntity fromResponse:response];
+                        for (NSString *relationshipName in relationshipRepresentations) {
+                            NSEntityDescription *destinationEntity = [representationMapping.destinationEntitiesByRelationshipName objectForKey:relationshipName];
+                            if (!destinationEntity) {
+                                continue;
+                            }
+                            
+                            id relationshipRepresentationOrArrayOfRepresentations = [relationshipRepresentations objectForKey:relationshipName];
+                            if ([representationMapping.toManyRelationshipNames containsObject:relationshipName]) {
+                                BOOL isOrdered = [representationMapping.orderedRelationshipNames containsObject:relationshipName];
+                                id mutableManagedRelationshipObjects = isOrdered ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
+                                id mutableBackingRelationshipObjects = isOrdered ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
+                                
+                                for (NSDictionary *relationshipRepresentation in relationshipRepresentationOrArrayOfRepresentations) {
+                                    NSManagedObject *backingRelationshipObject = nil;
+                                    NSManagedObject *managedRelationshipObject = managedObjectForRepresentation(relationshipRepresentation, destinationEntity, &backingRelationshipObject);
+                                    if (managedRelationshipObject) {
+                                        weakImportRelationshipsOfRepresentation(relationshipRepresentation, destinationEntity, backingRelationshipObject, managedRelationshipObject, depth + 1);
+                                        [mutableBackingRelationshipObjects addObject:backingRelationshipObject];
+                                        [mutableManagedRelationshipObjects addObject:managedRelationshipObject];
+                                    }
+                                }
+                                
+                                [backingContext performBlockAndWait:^{
+                                    AFSetChangedValueForKey(backingObject, mutableBackingRelationshipObjects, relationshipName);
+                                }];
+                                AFSetChangedValueForKey(managedObject, mutableManagedRelationshipObjects, relationshipName);
+                            } else {
+                                NSManagedObject *backingRelationshipObject = nil;
+                                NSManagedObject *managedRelationshipObject = managedObjectForRepresentation(relationshipRepresentationOrArrayOfRepresentations, destinationEntity, &backingRelationshipObject);
+                                if (managedRelationshipObject) {
+                                    weakImportRelationshipsOfRepresentation(relationshipRepresentationOrArrayOfRepresentations, destinationEntity, backingRelationshipObject, managedRelationshipObject, depth + 1);
+                                    [backingContext performBlockAndWait:^{
+                                        AFSetChangedValueForKey(backingObject, backingRelationshipObject, relationshipName);
+                                    }];
+                                    AFSetChangedValueForKey(managedObject, managedRelationshipObject, relationshipName);
+                                }
+                            }
+                        }
+                        
+                        [mutableObjectIDsBeingImported removeObject:objectID];
+                    };
+                    weakImportRelationshipsOfRepresentation = importRelationshipsOfRepresentation;
+                    
+                    for (NSDictionary *representation in batchOfRepresentations) {
+                        NSManagedObject *backingObject = nil;
+                        NSManagedObject *managedObject = managedObjectForRepresentation(representation, entity, &backingObject);
+                        if (!managedObject) {
+                            continue;
+                        }
+                        
+                        importRelationshipsOfRepresentation(representation, entity, backingObject, managedObject, 0);
+                        
+                        if (relationship) {
+                            [mutableRelationshipBackingObjects addObject:backingObject];
+                            [mutableRelationshipManagedObjects addObject:managedObject];
+                        }
+                    }
+                    
+                    // Objects fetched for a relationship fault are set as the value of that relationship once all of them are imported
+                    if (relationship && location + batchSize >= numberOfRepresentations) {
+                        NSManagedObject *managedObject = [childContext existingObjectWithID:[self objectIDForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]] error:nil];
+                        NSManagedObjectID *backingObjectID = [self objectIDForBackingObjectForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]];
+                        
+                        [backingContext performBlockAndWait:^{
+                            NSManagedObject *backingObject = (backingObjectID != nil) ? [backingContext existingObjectWithID:backingObjectID error:nil] : nil;
+                            AFSetChangedValueForKey(backingObject, [relationship isToMany] ? mutableRelationshipBackingObjects : [mutableRelationshipBackingObjects anyObject], relationship.name);
+                        }];
+                        
+                        AFSetChangedValueForKey(managedObject, [relationship isToMany] ? mutableRelationshipManagedObjects : [mutableRelationshipManagedObjects anyObject], relationship.name);
+                    }
+                    
+                    // Deleted resources are removed along with the last batch of representations, so that the changes are saved and merged together
+                    if ([deletedResourceIdentifiers count] > 0 && location + batchSize >= numberOfRepresentations) {
+                        NSDictionary *deletedBackingObjectIDs = [self objectIDsForBackingObjectsForEntity:entity withResourceIdentifiers:[NSSet setWithArray:deletedResourceIdentifiers] inBackingContext:backingContext];
+                        for (NSString *resourceIdentifier in deletedBackingObjectIDs) {
+                            NSManagedObject *managedObject = [childContext existingObjectWithID:[self objectIDForEntity:entity withResourceIdentifier:resourceIdentifier] error:nil];
+                            if (managedObject) {
+                                [childContext deleteObject:managedObject];
+                            }
+                        }
+                        
+                        [backingContext performBlockAndWait:^{
+                            for (NSManagedObjectID *backingObjectID in [deletedBackingObjectIDs allValues]) {
+                                NSManagedObject *backingObject = [backingContext existingObjectWithID:backingObjectID error:nil];
+                                if (backingObject) {
+                                    [backingContext deleteObject:backingObject];
+                                }
+                            }
+                        }];
+                    }
+                    
+                    [self didCompletePhase:AFIncrementalStoreImportPhase ofEntity:entity withURL:[response URL] startTime:importStartTime numberOfObjects:[batchOfRepresentations count]];
+                    
+                    __block NSError *saveError = nil;
+                    __block BOOL backingContextDidSave = NO;
+                    __block NSSet *importedBackingObjects = nil;
+                    CFAbsoluteTime backingSaveStartTime = CFAbsoluteTimeGetCurrent();
+                    [backingContext performBlockAndWait:^{
+                        importedBackingObjects = [[backingContext insertedObjects] setByAddingObjectsFromSet:[backingContext updatedObjects]];
+                        backingContextDidSave = ![backingContext hasChanges] || [backingContext save:&saveError];
+                    }];
+                    [self didCompletePhase:AFIncrementalStoreBackingSavePhase ofEntity:entity withURL:[response URL] startTime:backingSaveStartTime numberOfObjects:[importedBackingObjects count]];
+                    
+                    // A batch whose representations all match what is already stored leaves both contexts clean, and is not saved at all
+                    NSSet *insertedManagedObjects = [childContext insertedObjects];
+                    NSSet *updatedManagedObjects = [childContext updatedObjects];
+                    NSSet *deletedManagedObjects = [childContext deletedObjects];
+                    NSSet *importedManagedObjects = [insertedManagedObjects setByAddingObjectsFromSet:updatedManagedObjects];
+                    CFAbsoluteTime childSaveStartTime = CFAbsoluteTimeGetCurrent();
+                    BOOL childContextDidSave = backingContextDidSave && (![childContext hasChanges] || [childContext save:&saveError]);
+                    if (backingContextDidSave) {
+                        [self didCompletePhase:AFIncrementalStoreChildSavePhase ofEntity:entity withURL:[response URL] startTime:childSaveStartTime numberOfObjects:[importedManagedObjects count]];
+                    }
+                    
+                    if (!childContextDidSave) {
+                        [self didFailWithError:saveError];
+                        didImportAllBatches = NO;
+                    } else {
+                        [self enqueueMergeOfInsertedObjects:insertedManagedObjects updatedObjects:updatedManagedObjects deletedObjects:deletedManagedObjects intoContext:context];
+                    }
+                    
+                    // Turning saved objects back into faults releases their row data before the next batch is imported
+                    if (self.importBatchSize > 0) {
+                        [backingContext performBlockAndWait:^{
+                            for (NSManagedObject *backingObject in importedBackingObjects) {
+                                [backingContext refreshObject:backingObject mergeChanges:NO];
+                            }
+                        }];
+                        
+                        for (NSManagedObject *managedObject in importedManagedObjects) {
+                            [childContext refreshObject:managedObject mergeChanges:NO];
+                        }
+                    }
+                }
+            }
+            
+            if (completion) {
+                completion(didImportAllBatches);
+            }
+        }];
+
+        [[NSNotificationCenter defaultCenter] removeObserver:self name:nil object:backingContext];
+    }];
+    
+    NSSet *entityNames = [self entityNamesAffectedByImportOfEntity:entity];
+    __weak NSOperation *weakImportOperation = importOperation;
+    [importOperation setCompletionBlock:^{
+        dispatch_async(_importSchedulingQueue, ^{
+            for (NSString *entityName in entityNames) {
+                if ([_lastImportOperationsByEntityName objectForKey:entityName] == weakImportOperation) {
+                    [_lastImportOperationsByEntityName removeObjectForKey:entityName];
+                }
+            }
+        });
+    }];
+    
+    dispatch_sync(_importSchedulingQueue, ^{
+        for (NSString *entityName in entityNames) {
+            NSOperation *lastImportOperation = [_lastImportOperationsByEntityName objectForKey:entityName];
+            if (lastImportOperation && ![lastImportOperation isFinished]) {
+                [importOperation addDependency:lastImportOperation];
+            }
+            
+            [_lastImportOperationsByEntityName setObject:importOperation forKey:entityName];
+        }
+        
+        [_importOperationQueue addOperation:importOperation];
+    });
+}
+
+- (void)enqueueRemoteFetchRequest:(NSFetchRequest *)fetchRequest
+                   withPageCursor:(id)pageCursor
+                      withContext:(NSManagedObjectContext *)context
+                       completion:(void (^)(void))completion
+{
+    void (^completionCallback)(void) = completion ? [completion copy] : [^{} copy];
+    
+    BOOL isPaginated = [self.HTTPClient respondsToSelector:@selector(requestForFetchRequest:withPageCursor:withContext:)] && [self.HTTPClient respondsToSelector:@selector(pageCursorFollowingPageCursor:ofFetchRequest:withRepresentations:fromResponse:)];
+    NSURLRequest *request = isPaginated ? [self.HTTPClient requestForFetchRequest:fetchRequest withPageCursor:pageCursor withContext:context] : [self.HTTPClient requestForFetchRequest:fetchRequest withContext:context];
+    if (![request URL]) {
+        completionCallback();
+        return;
+    }
+    
+    // A fetch request whose first page was fetched within the time to live of its entity is fulfilled from the backing store alone
+    NSString *fetchRequestSignature = AFFetchRequestSignature(fetchRequest);
+    if (!pageCursor && [self isFreshLastFetchedDate:[self lastFetchedDateForKey:fetchRequestSignature ofEntity:fetchRequest.entity] forEntity:fetchRequest.entity]) {
+        completionCallback();
+        return;
+    }
+    
+    request = [self conditionalRequestForRequest:request];
+    CFAbsoluteTime requestStartTime = CFAbsoluteTimeGetCurrent();
+    [self enqueueHTTPRequestOperationWithRequest:request queuePriority:(pageCursor ? NSOperationQueuePriorityNormal : NSOperationQueuePriorityHigh) forFaultsOfObjectsWithIDs:nil success:^(AFHTTPRequestOperation *operation, id responseObject) {
+        [self didCompletePhase:AFIncrementalStoreRequestPhase ofEntity:fetchRequest.entity withURL:[request URL] startTime:requestStartTime numberOfObjects:0];
+        
+        CFAbsoluteTime mappingStartTime = CFAbsoluteTimeGetCurrent();
+        id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
+        
+        NSArray *representations = nil;
+        if ([representationOrArrayOfRepresentations isKindOfClass:[NSArray class]]) {
+            representations = representationOrArrayOfRepresentations;
+        } else {
+            representations = [NSArray arrayWithObject:representationOrArrayOfRepresentations];
+        }
+        [self didCompletePhase:AFIncrementalStoreResponseMappingPhase ofEntity:fetchRequest.entity withURL:[request URL] startTime:mappingStartTime numberOfObjects:[representations count]];
+        
+        // Validators and the last fetched date are only stored once the representations they are for are saved, so that a response that failed to import is neither revalidated with a `304 Not Modified` response, nor skipped as fresh
+        [self importRepresentations:representations ofEntity:fetchRequest.entity deletedResourceIdentifiers:nil forRelationship:nil ofObjectWithID:nil fromResponse:operation.response withContext:context completion:^(BOOL didImportAllBatches) {
+            if (didImportAllBatches) {
+                [self setHTTPValidatorsForRequest:request fromResponse:operation.response];
+                
+                if (!pageCursor) {
+                    [self setLastFetchedDateForKey:fetchRequestSignature ofEntity:fetchRequest.entity];
+                }
+            }
+            
+            completionCallback();
+        }];
+        
+        if (!isPaginated) {
+            return;
+        }
+        
+        id nextPageCursor = [representations count] > 0 ? [self.HTTPClient pageCursorFollowingPageCursor:pageCursor ofFetchRequest:fetchRequest withRepresentations:representations fromResponse:operation.response] : nil;
+        
+        // The next page is requested once the first object of the last batch of the current page is faulted, which is when a fetched results controller scrolls into that batch
+        NSUInteger batchSize = MAX(fetchRequest.fetchBatchSize, (NSUInteger)1);
+        NSDictionary *thresholdRepresentation = [representations count] > 0 ? [representations objectAtIndex:([representations count] > batchSize ? [representations count] - batchSize : 0)] : nil;
+        NSString *thresholdResourceIdentifier = thresholdRepresentation ? [self.HTTPClient resourceIdentifierForRepresentation:thresholdRepresentation ofEntity:fetchRequest.entity fromResponse:operation.response] : nil;
+        NSManagedObjectID *thresholdObjectID = thresholdResourceIdentifier ? [self objectIDForEntity:fetchRequest.entity withResourceIdentifier:thresholdResourceIdentifier] : nil;
+        
+        dispatch_sync(_paginationQueue, ^{
+            // Fetching the first page again starts the pagination of that fetch request over
+            NSUInteger numberOfObjects = [representations count];
+            if (pageCursor) {
+                numberOfObjects += [[[_paginationStatesByFetchRequestSignature objectForKey:fetchRequestSignature] objectForKey:kAFIncrementalStorePaginationNumberOfObjectsKey] unsignedIntegerValue];
+            }
+            
+            NSMutableDictionary *mutablePaginationState = nil;
+            if (nextPageCursor && thresholdObjectID && (fetchRequest.fetchLimit == 0 || numberOfObjects < fetchRequest.fetchLimit)) {
+                mutablePaginationState = [NSMutableDictionary dictionaryWithCapacity:4];
+                [mutablePaginationState setObject:[fetchRequest copy] forKey:kAFIncrementalStorePaginationFetchRequestKey];
+                [mutablePaginationState setObject:nextPageCursor forKey:kAFIncrementalStorePaginationPageCursorKey];
+                [mutablePaginationState setObject:[NSNumber numberWithUnsignedInteger:numberOfObjects] forKey:kAFIncrementalStorePaginationNumberOfObjectsKey];
+                [mutablePaginationState setObject:thresholdObjectID forKey:kAFIncrementalStorePaginationThresholdObjectIDKey];
+            }
+            
+            // The state following each page is kept, so that a page revalidated with a `304 Not Modified` response resumes the pagination that followed it
+            [_paginationStatesFollowingRequestSignature setObject:(mutablePaginationState ?: [NSNull null]) forKey:AFRequestSignature(request)];
+            [self setPaginationState:mutablePaginationState forFetchRequestSignature:fetchRequestSignature];
+        });
+    } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+        // A `304 Not Modified` response, which is outside the acceptable status codes of HTTP request operations, means the backing store already holds the current representations, so there is nothing to map or save
+        if ([operation.response statusCode] == 304) {
+            __block BOOL didResumePagination = NO;
+            if (isPaginated) {
+                dispatch_sync(_paginationQueue, ^{
+                    id paginationState = [_paginationStatesFollowingRequestSignature objectForKey:AFRequestSignature(request)];
+                    if (paginationState) {
+                        [self setPaginationState:(paginationState != [NSNull null] ? paginationState : nil) forFetchRequestSignature:fetchRequestSignature];
+                        didResumePagination = YES;
+                    }
+                });
+            }
+            
+            // A page whose following page cursor is unknown, such as one loaded before the app was last launched, is requested again without its validators, so that its pagination can be resumed
+            if (isPaginated && !didResumePagination && [self removeHTTPValidatorsForRequest:request]) {
+                [self enqueueRemoteFetchRequest:fetchRequest withPageCursor:pageCursor withContext:context completion:completionCallback];
+                return;
+            }
+            
+            if (!pageCursor) {
+                [self setLastFetchedDateForKey:fetchRequestSignature ofEntity:fetchRequest.entity];
+            }
+        } else {
+            [self didFailWithError:error];
+        }
+        
+        completionCallback();
+    }];
+}
+
+- (void)enqueueRemoteChangesFetchForEntity:(NSEntityDescription *)entity
+                               withContext:(NSManagedObjectContext *)context
+                                completion:(void (^)(void))completion
+{
+    void (^completionCallback)(void) = completion ? [completion copy] : [^{} copy];
+    
+    // Changes are requested at most once within the time to live of the entity, as the sync token identifies the request rather than the resources it is for
+    if ([self isFreshLastFetchedDate:[self lastFetchedDateForKey:entity.name ofEntity:entity] forEntity:entity]) {
+        completionCallback();
+        return;
+    }
+    
+    id syncToken = [[self metadataValueForKey:kAFIncrementalStoreSyncTokensMetadataKey] objectForKey:entity.name];
+    NSURLRequest *request = [self.HTTPClient requestForChangesToEntity:entity sinceSyncToken:syncToken withContext:context];
+    if (![request URL]) {
+        completionCallback();
+        return;
+    }
+    
+    CFAbsoluteTime requestStartTime = CFAbsoluteTimeGetCurrent();
+    [self enqueueHTTPRequestOperationWithRequest:request queuePriority:NSOperationQueuePriorityHigh forFaultsOfObjectsWithIDs:nil success:^(AFHTTPRequestOperation *operation, id responseObject) {
+        [self didCompletePhase:AFIncrementalStoreRequestPhase ofEntity:entity withURL:[request URL] startTime:requestStartTime numberOfObjects:0];
+        
+        CFAbsoluteTime mappingStartTime = CFAbsoluteTimeGetCurrent();
+        id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
+        
+        NSArray *representations = nil;
+        if ([representationOrArrayOfRepresentations isKindOfClass:[NSArray class]]) {
+            representations = representationOrArrayOfRepresentations;
+        } else if (representationOrArrayOfRepresentations) {
+            representations = [NSArray arrayWithObject:representationOrArrayOfRepresentations];
+        }
+        [self didCompletePhase:AFIncrementalStoreResponseMappingPhase ofEntity:entity withURL:[request URL] startTime:mappingStartTime numberOfObjects:[representations count]];
+        
+        NSArray *deletedResourceIdentifiers = [self.HTTPClient resourceIdentifiersOfDeletedResourcesFromResponseObject:responseObject ofEntity:entity fromResponse:operation.response];
+        id nextSyncToken = [self.HTTPClient syncTokenFromResponseObject:responseObject ofEntity:entity fromResponse:operation.response];
+        
+        // The sync token only advances, and the entity is only considered fresh, once the changes it covers are saved, so that changes that failed to import are requested again
+        [self importRepresentations:representations ofEntity:entity deletedResourceIdentifiers:deletedResourceIdentifiers forRelationship:nil ofObjectWithID:nil fromResponse:operation.response withContext:context completion:^(BOOL didImportAllBatches) {
+            if (didImportAllBatches) {
+                [self setLastFetchedDateForKey:entity.name ofEntity:entity];
+            }
+            
+            if (didImportAllBatches && nextSyncToken && ![nextSyncToken isEqual:syncToken]) {
+                [self updateMetadataValueForKey:kAFIncrementalStoreSyncTokensMetadataKey usingBlock:^id(NSDictionary *syncTokensByEntityName) {
+                    NSMutableDictionary *mutableSyncTokensByEntityName = [syncTokensByEntityName mutableCopy] ?: [NSMutableDictionary dictionary];
+                    [mutableSyncTokensByEntityName setObject:nextSyncToken forKey:entity.name];
+                    
+                    return mutableSyncTokensByEntityName;
+                }];
+            }
+            
+            completionCallback();
+        }];
+    } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+        [self didFailWithError:error];
+        completionCallback();
+    }];
+}
+
+- (void)setPaginationState:(NSDictionary *)paginationState
+  forFetchRequestSignature:(NSString *)fetchRequestSignature
+{
+    // Must be called on the pagination queue
+    NSManagedObjectID *previousThresholdObjectID = [[_paginationStatesByFetchRequestSignature objectForKey:fetchRequestSignature] objectForKey:kAFIncrementalStorePaginationThresholdObjectIDKey];
+    if (previousThresholdObjectID) {
+        [_fetchRequestSignaturesByThresholdObjectID removeObjectForKey:previousThresholdObjectID];
+    }
+    
+    if (!paginationState) {
+        [_paginationStatesByFetchRequestSignature removeObjectForKey:fetchRequestSignature];
+        return;
+    }
+    
+    [_paginationStatesByFetchRequestSignature setObject:paginationState forKey:fetchRequestSignature];
+    [_fetchRequestSignaturesByThresholdObjectID setObject:fetchRequestSignature forKey:[paginationState objectForKey:kAFIncrementalStorePaginationThresholdObjectIDKey]];
+}
+
+- (void)enqueueNextPageIfNeededForObjectWithID:(NSManagedObjectID *)objectID
+                                   withContext:(NSManagedObjectContext *)context
+{
+    // Objects faulted while importing a page are not being displayed, and must not trigger the loading of the next one
+    if ([[context.userInfo objectForKey:kAFIncrementalStoreImportContextKey] boolValue]) {
+        return;
+    }
+    
+    __block NSDictionary *paginationState = nil;
+    dispatch_sync(_paginationQueue, ^{
+        NSString *fetchRequestSignature = [_fetchRequestSignaturesByThresholdObjectID objectForKey:objectID];
+        if (fetchRequestSignature) {
+            [_fetchRequestSignaturesByThresholdObjectID removeObjectForKey:objectID];
+            paginationState = [_paginationStatesByFetchRequestSignature objectForKey:fetchRequestSignature];
+        }
+    });
+    
+    if (paginationState) {
+        [self enqueueRemoteFetchRequest:[paginationState objectForKey:kAFIncrementalStorePaginationFetchRequestKey] withPageCursor:[paginationState objectForKey:kAFIncrementalStorePaginationPageCursorKey] withContext:context completion:nil];
+    }
+}
+
+- (id)executeRequest:(NSPersistentStoreRequest *)persistentStoreRequest
+         withContext:(NSManagedObjectContext *)context
+               error:(NSError *__autoreleasing *)error
+{
+    if (persistentStoreRequest.requestType == NSFetchRequestType) {
+        NSFetchRequest *fetchRequest = (NSFetchRequest *)persistentStoreRequest;
+        
+        BOOL isSynchronizedIncrementally = [self.HTTPClient respondsToSelector:@selector(requestForChangesToEntity:sinceSyncToken:withContext:)] && [self.HTTPClient respondsToSelector:@selector(syncTokenFromResponseObject:ofEntity:fromResponse:)] && [self.HTTPClient respondsToSelector:@selector(resourceIdentifiersOfDeletedResourcesFromResponseObject:ofEntity:fromResponse:)];
+        if (isSynchronizedIncrementally) {
+            [self enqueueRemoteChangesFetchForEntity:fetchRequest.entity withContext:context completion:nil];
+        } else {
+            [self enqueueRemoteFetchRequest:fetchRequest withPageCursor:nil withContext:context completion:nil];
+        }
+        
+        NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+        __block NSArray *results = nil;
+        __block NSError *fetchError = nil;
+        
+        NSFetchRequestResultType resultType = fetchRequest.resultType;
+        switch (resultType) {
+            case NSManagedObjectResultType:
+            case NSManagedObjectIDResultType: {
+                // Backing objects are fetched by ID alone, and mapped to frontend object IDs through the cache, so that no row data or resource identifiers are read for objects that have been seen before
+                NSFetchRequest *backingFetchRequest = [fetchRequest copy];
+                backingFetchRequest.entity = [NSEntityDescription entityForName:fetchRequest.entityName inManagedObjectContext:backingContext];
+                NSArray *relationshipKeyPathsForPrefetching = fetchRequest.relationshipKeyPathsForPrefetching;
+                if ([relationshipKeyPathsForPrefetching count] > 0) {
+                    backingFetchRequest.resultType = NSManagedObjectResultType;
+                    backingFetchRequest.returnsObjectsAsFaults = NO;
+                } else {
+                    backingFetchRequest.resultType = NSManagedObjectIDResultType;
+                }
+                
+                [backingContext performBlockAndWait:^{
+                    results = [backingContext executeFetchRequest:backingFetchRequest error:&fetchError];
+                    
+                    // Prefetched objects are registered with the backing context, and their IDs cached, so that walking the key paths across the results fulfills each fault without going to the store
+                    if ([relationshipKeyPathsForPrefetching count] > 0) {
+                        [self cacheBackingObjectIDsOfBackingObjects:results];
+                        for (NSString *keyPath in relationshipKeyPathsForPrefetching) {
+                            id <NSFastEnumeration> backingObjects = results;
+                            for (NSString *key in [keyPath componentsSeparatedByString:@"."]) {
+                                NSMutableSet *mutableDestinationBackingObjects = [NSMutableSet set];
+                                for (NSManagedObject *backingObject in backingObjects) {
+                                    id value = [backingObject valueForKey:key];
+                                    if ([value isKindOfClass:[NSManagedObject class]]) {
+                                        [mutableDestinationBackingObjects addObject:value];
+                                    } else if ([value conformsToProtocol:@protocol(NSFastEnumeration)]) {
+                                        for (NSManagedObject *destinationBackingObject in value) {
+                                            [mutableDestinationBackingObjects addObject:destinationBackingObject];
+                                        }
+                                    }
+                                }
+                                
+                                [self cacheBackingObjectIDsOfBackingObjects:mutableDestinationBackingObjects];
+                                backingObjects = mutableDestinationBackingObjects;
+                            }
+                        }
+                        
+                        results = [results valueForKey:@"objectID"];
+                    }
+                }];
+                if (fetchError) {
+                    if (error) {
+                        *error = fetchError;
+                    }
+                    
+                    return nil;
+                }
+                
+                NSArray *objectIDs = [self objectIDsForBackingObjectIDs:results ofEntity:fetchRequest.entity batchSize:fetchRequest.fetchBatchSize error:error];
+                if (resultType == NSManagedObjectIDResultType || !objectIDs) {
+                    return objectIDs;
+                }
+                
+                // Objects are returned as faults, whose values are only fulfilled by `-newValuesForObjectWithID:withContext:error:` once they are accessed
+                NSMutableArray *mutableObjects = [NSMutableArray arrayWithCapacity:[objectIDs count]];
+                for (NSManagedObjectID *objectID in objectIDs) {
+                    [mutableObjects addObject:[context objectWithID:objectID]];
+                }
+                
+                return mutableObjects;
+            }
+            case NSDictionaryResultType:
+            case NSCountResultType:
+                [backingContext performBlockAndWait:^{
+                    results = [backingContext executeFetchRequest:fetchRequest error:&fetchError];
+                }];
+                if (fetchError && error) {
+                    *error = fetchError;
+                }
+                
+                return results;
+            default:
+                goto _error;
+        }
+    } else {
+        switch (persistentStoreRequest.requestType) {
+            case NSSaveRequestType:
+                return [self executeSaveChangesRequest:(NSSaveChangesRequest *)persistentStoreRequest withContext:context error:error];
+            default:
+                goto _error;
+        }
+    }
+    
+    return nil;
+    
+    _error: {
+        NSMutableDictionary *mutableUserInfo = [NSMutableDictionary dictionary];
+        [mutableUserInfo setValue:[NSString stringWithFormat:NSLocalizedString(@"Unsupported NSFetchRequestResultType, %d", nil), persistentStoreRequest.requestType] forKey:NSLocalizedDescriptionKey];
+        if (error) {
+            *error = [[NSError alloc] initWithDomain:AFNetworkingErrorDomain code:0 userInfo:mutableUserInfo];
+        }
+    
+        return nil;
+    }
+}
+
+- (id)executeSaveChangesRequest:(NSSaveChangesRequest *)saveChangesRequest
+                    withContext:(NSManagedObjectContext *)context
+                          error:(NSError *__autoreleasing *)error
 {
-    if ([self.HTTPClient respondsToSelector:@selector(shouldFetchRemoteValuesForRelationship:forObjectWithID:inManagedObjectContext:)] && [self.HTTPClient shouldFetchRemoteValuesForRelationship:relationship forObjectWithID:objectID inManagedObjectContext:context]) {
-        NSURLRequest *request = [self.HTTPClient requestWithMethod:@"GET" pathForRelationship:relationship forObjectWithID:objectID withContext:context];
+    BOOL isBatchingOutboundChanges = [self.HTTPClient respondsToSelector:@selector(requestForInsertedObjects:updatedObjects:deletedObjects:withContext:)];
+    BOOL isSendingInsertedObjects = isBatchingOutboundChanges || [self.HTTPClient respondsToSelector:@selector(requestForInsertedObject:)];
+    BOOL isSendingUpdatedObjects = isBatchingOutboundChanges || [self.HTTPClient respondsToSelector:@selector(requestForUpdatedObject:)];
+    BOOL isSendingDeletedObjects = isBatchingOutboundChanges || [self.HTTPClient respondsToSelector:@selector(requestForDeletedObject:)];
+    
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    __block BOOL didSave = NO;
+    __block NSError *saveError = nil;
+    __block NSUInteger numberOfOutboundChanges = 0;
+    [backingContext performBlockAndWait:^{
+        NSMutableArray *mutableOutboundChanges = [NSMutableArray array];
+        void (^addOutboundChange)(NSString *, NSManagedObject *) = ^(NSString *type, NSManagedObject *managedObject) {
+            NSDictionary *outboundChange = [NSDictionary dictionaryWithObjectsAndKeys:[[NSProcessInfo processInfo] globallyUniqueString], kAFIncrementalStoreOutboundChangeIdentifierKey, type, kAFIncrementalStoreOutboundChangeTypeKey, managedObject.entity.name, kAFIncrementalStoreOutboundChangeEntityNameKey, [super referenceObjectForObjectID:managedObject.objectID], kAFIncrementalStoreOutboundChangeResourceIdentifierKey, nil];
+            [mutableOutboundChanges addObject:outboundChange];
+        };
+        
+        NSMutableDictionary *mutableBackingObjectsByObjectID = [NSMutableDictionary dictionary];
+        NSManagedObject * (^backingObjectForObjectID)(NSManagedObjectID *) = ^NSManagedObject *(NSManagedObjectID *objectID) {
+            NSManagedObject *backingObject = [mutableBackingObjectsByObjectID objectForKey:objectID];
+            if (!backingObject) {
+                NSManagedObjectID *backingObjectID = [self objectIDForBackingObjectForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]];
+                backingObject = (backingObjectID != nil) ? [backingContext existingObjectWithID:backingObjectID error:nil] : nil;
+                if (backingObject) {
+                    [mutableBackingObjectsByObjectID setObject:backingObject forKey:objectID];
+                }
+            }
+            
+            return backingObject;
+        };
+        
+        // Backing objects are created for every inserted object before any values are set, so that relationships among the inserted objects can be assigned. Objects inserted by an import are saved into the context that started it, and already have a backing object
+        for (NSManagedObject *insertedObject in [saveChangesRequest insertedObjects]) {
+            if (backingObjectForObjectID(insertedObject.objectID)) {
+                continue;
+            }
+            
+            NSManagedObject *backingObject = [NSEntityDescription insertNewObjectForEntityForName:insertedObject.entity.name inManagedObjectContext:backingContext];
+            [backingObject setValue:[self referenceObjectForObjectID:insertedObject.objectID] forKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+            [mutableBackingObjectsByObjectID setObject:backingObject forKey:insertedObject.objectID];
+            
+            // Only objects created locally, which are identified by a local resource identifier until the server assigns them one, are sent to the server
+            id resourceIdentifier = [super referenceObjectForObjectID:insertedObject.objectID];
+            if (isSendingInsertedObjects && [resourceIdentifier isKindOfClass:[NSString class]] && [resourceIdentifier hasPrefix:kAFIncrementalStoreLocalResourceIdentifierPrefix]) {
+                addOutboundChange(NSInsertedObjectsKey, insertedObject);
+            }
+        }
+        
+        NSMutableSet *mutableChangedObjects = [NSMutableSet setWithSet:[saveChangesRequest insertedObjects]];
+        [mutableChangedObjects unionSet:[saveChangesRequest updatedObjects]];
+        for (NSManagedObject *managedObject in mutableChangedObjects) {
+            NSManagedObject *backingObject = backingObjectForObjectID(managedObject.objectID);
+            if (!backingObject) {
+                backingObject = [NSEntityDescription insertNewObjectForEntityForName:managedObject.entity.name inManagedObjectContext:backingContext];
+                [backingObject setValue:[self referenceObjectForObjectID:managedObject.objectID] forKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+                [mutableBackingObjectsByObjectID setObject:backingObject forKey:managedObject.objectID];
+            }
+            
+            AFEntityMapping *mapping = [self mappingForEntity:managedObject.entity];
+            AFSetChangedValuesForKeysWithDictionary(backingObject, [managedObject dictionaryWithValuesForKeys:mapping.attributeNames]);
+            
+            // Relationships that are still faults have not been changed, and are left as they are rather than being fired
+            for (NSString *relationshipName in mapping.relationshipsByName) {
+                if ([managedObject hasFaultForRelationshipNamed:relationshipName]) {
+                    continue;
+                }
+                
+                id value = [managedObject valueForKey:relationshipName];
+                id backingValue = nil;
+                if ([mapping.toManyRelationshipNames containsObject:relationshipName]) {
+                    id mutableBackingRelationshipObjects = [mapping.orderedRelationshipNames containsObject:relationshipName] ? [NSMutableOrderedSet orderedSet] : [NSMutableSet set];
+                    for (NSManagedObject *relationshipObject in value) {
+                        NSManagedObject *backingRelationshipObject = backingObjectForObjectID(relationshipObject.objectID);
+                        if (backingRelationshipObject) {
+                            [mutableBackingRelationshipObjects addObject:backingRelationshipObject];
+                        }
+                    }
+                    backingValue = mutableBackingRelationshipObjects;
+                } else if (value) {
+                    backingValue = backingObjectForObjectID([(NSManagedObject *)value objectID]);
+                }
+                
+                AFSetChangedValueForKey(backingObject, backingValue, relationshipName);
+            }
+            
+            // Objects updated by an import have already been written to the backing store, and only changes made locally are sent to the server
+            if (isSendingUpdatedObjects && ![backingObject isInserted] && [[backingObject changedValues] count] > 0) {
+                addOutboundChange(NSUpdatedObjectsKey, managedObject);
+            }
+        }
+        
+        for (NSManagedObject *deletedObject in [saveChangesRequest deletedObjects]) {
+            NSManagedObject *backingObject = backingObjectForObjectID(deletedObject.objectID);
+            if (backingObject) {
+                [backingContext deleteObject:backingObject];
+                
+                if (isSendingDeletedObjects) {
+                    addOutboundChange(NSDeletedObjectsKey, deletedObject);
+                }
+            }
+        }
+        
+        // Outbound changes are recorded in the metadata of the backing store, and saved along with the changes themselves
+        [self recordOutboundChanges:mutableOutboundChanges];
+        numberOfOutboundChanges = [mutableOutboundChanges count];
+        
+        didSave = ![backingContext hasChanges] || [backingContext save:&saveError];
+    }];
+    
+    if (!didSave) {
+        if (error) {
+            *error = saveError;
+        }
+        
+        return nil;
+    }
+    
+    if (numberOfOutboundChanges > 0) {
+        [self sendOutboundChanges];
+    }
+    
+    return [NSArray array];
+}
+
+- (void)recordOutboundChanges:(NSArray *)outboundChanges {
+    if ([outboundChanges count] == 0) {
+        return;
+    }
+    
+    dispatch_sync(_outboundChangesQueue, ^{
+        NSMutableArray *mutablePendingOutboundChanges = [[self metadataValueForKey:kAFIncrementalStoreOutboundChangesMetadataKey] mutableCopy] ?: [NSMutableArray array];
+        for (NSDictionary *outboundChange in outboundChanges) {
+            // Changes are coalesced with a pending change to the same resource, unless that change is already being sent
+            NSUInteger idx = [mutablePendingOutboundChanges indexOfObjectPassingTest:^BOOL(NSDictionary *pendingOutboundChange, __unused NSUInteger pendingIdx, __unused BOOL *stop) {
+                return [[pendingOutboundChange objectForKey:kAFIncrementalStoreOutboundChangeEntityNameKey] isEqualToString:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeEntityNameKey]] && [[pendingOutboundChange objectForKey:kAFIncrementalStoreOutboundChangeResourceIdentifierKey] isEqual:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeResourceIdentifierKey]] && ![_outboundChangesInFlight containsObject:pendingOutboundChange];
+            }];
+            
+            if (idx == NSNotFound) {
+                [mutablePendingOutboundChanges addObject:outboundChange];
+                continue;
+            }
+            
+            // A pending insertion or update already sends the latest values of the object, whereas a deletion replaces a pending update, and cancels a pending insertion altogether
+            if ([[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeTypeKey] isEqualToString:NSDeletedObjectsKey]) {
+                NSString *pendingType = [[mutablePendingOutboundChanges objectAtIndex:idx] objectForKey:kAFIncrementalStoreOutboundChangeTypeKey];
+                [mutablePendingOutboundChanges removeObjectAtIndex:idx];
+                if (![pendingType isEqualToString:NSInsertedObjectsKey]) {
+                    [mutablePendingOutboundChanges addObject:outboundChange];
+                }
+            }
+        }
+        
+        [self setMetadataValue:mutablePendingOutboundChanges forKey:kAFIncrementalStoreOutboundChangesMetadataKey];
+    });
+}
+
+- (void)sendOutboundChanges {
+    if (!self.HTTPClient) {
+        return;
+    }
+    
+    __block NSArray *outboundChanges = nil;
+    dispatch_sync(_outboundChangesQueue, ^{
+        if (_outboundChangesInFlight) {
+            return;
+        }
+        
+        outboundChanges = [self metadataValueForKey:kAFIncrementalStoreOutboundChangesMetadataKey];
+        if ([outboundChanges count] > 0) {
+            _outboundChangesInFlight = outboundChanges;
+        }
+    });
+    
+    if ([outboundChanges count] == 0) {
+        return;
+    }
+    
+    // Objects are read for the HTTP client through a context of their own, whose faults are fulfilled from the backing store only
+    NSManagedObjectContext *outboundContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    outboundContext.persistentStoreCoordinator = self.persistentStoreCoordinator;
+    [outboundContext.userInfo setObject:[NSNumber numberWithBool:YES] forKey:kAFIncrementalStoreImportContextKey];
+    [outboundContext performBlock:^{
+        NSDictionary *entitiesByName = [self.persistentStoreCoordinator.managedObjectModel entitiesByName];
+        NSMutableArray *mutableObjects = [NSMutableArray arrayWithCapacity:[outboundChanges count]];
+        NSMutableDictionary *mutableObjectsByType = [NSMutableDictionary dictionaryWithObjectsAndKeys:[NSMutableArray array], NSInsertedObjectsKey, [NSMutableArray array], NSUpdatedObjectsKey, [NSMutableArray array], NSDeletedObjectsKey, nil];
+        for (NSDictionary *outboundChange in outboundChanges) {
+            NSEntityDescription *entity = [entitiesByName objectForKey:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeEntityNameKey]];
+            NSManagedObjectID *objectID = [self newObjectIDForEntity:entity referenceObject:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeResourceIdentifierKey]];
+            NSManagedObject *managedObject = [outboundContext objectWithID:objectID];
+            [mutableObjects addObject:managedObject];
+            [[mutableObjectsByType objectForKey:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeTypeKey]] addObject:managedObject];
+        }
+        
+        NSArray *insertedObjects = [mutableObjectsByType objectForKey:NSInsertedObjectsKey];
+        NSArray *insertedOutboundChanges = [outboundChanges filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"%K == %@", kAFIncrementalStoreOutboundChangeTypeKey, NSInsertedObjectsKey]];
+        
+        // With a bulk endpoint, every pending change is sent in a single request, and the representations in the response correspond, in order, to the inserted objects
+        NSURLRequest *batchRequest = nil;
+        if ([self.HTTPClient respondsToSelector:@selector(requestForInsertedObjects:updatedObjects:deletedObjects:withContext:)]) {
+            batchRequest = [self.HTTPClient requestForInsertedObjects:insertedObjects updatedObjects:[mutableObjectsByType objectForKey:NSUpdatedObjectsKey] deletedObjects:[mutableObjectsByType objectForKey:NSDeletedObjectsKey] withContext:outboundContext];
+        }
+        
+        if ([batchRequest URL]) {
+            [self enqueueHTTPRequestOperationWithRequest:batchRequest success:^(AFHTTPRequestOperation *operation, id responseObject) {
+                id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
+                NSArray *representations = [representationOrArrayOfRepresentations isKindOfClass:[NSArray class]] ? representationOrArrayOfRepresentations : [NSArray arrayWithObject:representationOrArrayOfRepresentations];
+                [insertedOutboundChanges enumerateObjectsUsingBlock:^(NSDictionary *outboundChange, NSUInteger idx, BOOL *stop) {
+                    if (idx >= [representations count]) {
+                        *stop = YES;
+                        return;
+                    }
+                    
+                    NSEntityDescription *entity = [entitiesByName objectForKey:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeEntityNameKey]];
+                    [self setResourceIdentifierFromResponseObject:[representations objectAtIndex:idx] ofInsertedObjectWithLocalResourceIdentifier:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeResourceIdentifierKey] ofEntity:entity fromResponse:operation.response];
+                }];
+                
+                [self didSendOutboundChanges:outboundChanges failedOutboundChanges:nil];
+            } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+                [self didFailWithError:error];
+                [self didSendOutboundChanges:outboundChanges failedOutboundChanges:outboundChanges];
+            }];
+            
+            return;
+        }
         
-        if ([request URL] && ![[context existingObjectWithID:objectID error:nil] hasChanges]) {
-            NSManagedObjectContext *childContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
-            childContext.parentContext = context;
-            childContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
+        // Otherwise, each change is sent in a request of its own, and all of them are in flight at once
+        dispatch_group_t group = dispatch_group_create();
+        NSMutableArray *mutableFailedOutboundChanges = [NSMutableArray array];
+        [outboundChanges enumerateObjectsUsingBlock:^(NSDictionary *outboundChange, NSUInteger idx, __unused BOOL *stop) {
+            NSManagedObject *managedObject = [mutableObjects objectAtIndex:idx];
+            NSString *type = [outboundChange objectForKey:kAFIncrementalStoreOutboundChangeTypeKey];
+            NSURLRequest *request = nil;
+            if ([type isEqualToString:NSInsertedObjectsKey] && [self.HTTPClient respondsToSelector:@selector(requestForInsertedObject:)]) {
+                request = [self.HTTPClient requestForInsertedObject:managedObject];
+            } else if ([type isEqualToString:NSUpdatedObjectsKey] && [self.HTTPClient respondsToSelector:@selector(requestForUpdatedObject:)]) {
+                request = [self.HTTPClient requestForUpdatedObject:managedObject];
+            } else if ([type isEqualToString:NSDeletedObjectsKey] && [self.HTTPClient respondsToSelector:@selector(requestForDeletedObject:)]) {
+                request = [self.HTTPClient requestForDeletedObject:managedObject];
+            }
             
-            NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+            // Changes the HTTP client has no request for are dropped, rather than retried forever
+            if (![request URL]) {
+                return;
+            }
             
-            [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification object:childContext queue:[NSOperationQueue mainQueue] usingBlock:^(NSNotification *note) {
-                [context mergeChangesFromContextDidSaveNotification:note];
+            dispatch_group_enter(group);
+            [self enqueueHTTPRequestOperationWithRequest:request success:^(AFHTTPRequestOperation *operation, id responseObject) {
+                if ([type isEqualToString:NSInsertedObjectsKey]) {
+                    id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
+                    id representation = [representationOrArrayOfRepresentations isKindOfClass:[NSArray class]] ? [representationOrArrayOfRepresentations lastObject] : representationOrArrayOfRepresentations;
+                    [self setResourceIdentifierFromResponseObject:representation ofInsertedObjectWithLocalResourceIdentifier:[outboundChange objectForKey:kAFIncrementalStoreOutboundChangeResourceIdentifierKey] ofEntity:managedObject.entity fromResponse:operation.response];
+                }
+                
+                dispatch_group_leave(group);
+            } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+                [self didFailWithError:error];
+                dispatch_sync(_outboundChangesQueue, ^{
+                    [mutableFailedOutboundChanges addObject:outboundChange];
+                });
+                
+                dispatch_group_leave(group);
             }];
+        }];
+        
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+            [self didSendOutboundChanges:outboundChanges failedOutboundChanges:mutableFailedOutboundChanges];
+        });
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(group);
+#endif
+    }];
+}
+
+- (void)didSendOutboundChanges:(NSArray *)outboundChanges
+         failedOutboundChanges:(NSArray *)failedOutboundChanges
+{
+    __block NSUInteger numberOfPendingOutboundChanges = 0;
+    __block NSTimeInterval retryInterval = 0.0;
+    dispatch_sync(_outboundChangesQueue, ^{
+        NSMutableArray *mutablePendingOutboundChanges = [[self metadataValueForKey:kAFIncrementalStoreOutboundChangesMetadataKey] mutableCopy];
+        for (NSDictionary *outboundChange in outboundChanges) {
+            if (![failedOutboundChanges containsObject:outboundChange]) {
+                [mutablePendingOutboundChanges removeObject:outboundChange];
+            }
+        }
+        [self setMetadataValue:mutablePendingOutboundChanges forKey:kAFIncrementalStoreOutboundChangesMetadataKey];
+        numberOfPendingOutboundChanges = [mutablePendingOutboundChanges count];
+        
+        // Failed changes are retried with exponential backoff, and the interval is reset as soon as a batch goes through
+        _outboundChangesRetryInterval = ([failedOutboundChanges count] > 0) ? MIN(MAX(_outboundChangesRetryInterval * 2.0, 1.0), kAFIncrementalStoreMaximumOutboundChangesRetryInterval) : 0.0;
+        retryInterval = _outboundChangesRetryInterval;
+        _outboundChangesInFlight = nil;
+    });
+    
+    if (numberOfPendingOutboundChanges == 0) {
+        return;
+    }
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(retryInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [self sendOutboundChanges];
+    });
+}
+
+- (void)setResourceIdentifierFromResponseObject:(id)responseObject
+                 ofInsertedObjectWithLocalResourceIdentifier:(NSString *)localResourceIdentifier
+                                        ofEntity:(NSEntityDescription *)entity
+                                    fromResponse:(NSHTTPURLResponse *)response
+{
+    if (![responseObject isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+    
+    NSString *resourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:responseObject ofEntity:entity fromResponse:response];
+    if (!resourceIdentifier || [resourceIdentifier isEqualToString:localResourceIdentifier]) {
+        return;
+    }
+    
+    // The backing object takes on the resource identifier assigned by the server, and the local resource identifier of its managed object becomes an alias for it, so that object IDs handed out before remain valid
+    NSManagedObjectID *backingObjectID = [self objectIDForBackingObjectForEntity:entity withResourceIdentifier:localResourceIdentifier];
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    [backingContext performBlockAndWait:^{
+        NSMutableDictionary *mutableResourceIdentifierAliases = [[self metadataValueForKey:kAFIncrementalStoreResourceIdentifierAliasesMetadataKey] mutableCopy] ?: [NSMutableDictionary dictionary];
+        [mutableResourceIdentifierAliases setObject:resourceIdentifier forKey:localResourceIdentifier];
+        [self setMetadataValue:mutableResourceIdentifierAliases forKey:kAFIncrementalStoreResourceIdentifierAliasesMetadataKey];
+        
+        NSManagedObject *backingObject = (backingObjectID != nil) ? [backingContext existingObjectWithID:backingObjectID error:nil] : nil;
+        [backingObject setValue:resourceIdentifier forKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+        
+        NSError *saveError = nil;
+        if ([backingContext hasChanges] && ![backingContext save:&saveError]) {
+            [self didFailWithError:saveError];
+        }
+    }];
+    
+    dispatch_barrier_async(_registeredObjectIDsQueue, ^{
+        NSMutableDictionary *mutableObjectIDsByResourceIdentifier = [_registeredObjectIDsByResourceIdentifierByEntityName objectForKey:AFRootEntityName(entity)];
+        NSManagedObjectID *objectID = [mutableObjectIDsByResourceIdentifier objectForKey:localResourceIdentifier];
+        if (objectID) {
+            [mutableObjectIDsByResourceIdentifier removeObjectForKey:localResourceIdentifier];
+            [mutableObjectIDsByResourceIdentifier setObject:objectID forKey:resourceIdentifier];
+        }
+    });
+}
+
+#pragma mark -
+
+- (NSIncrementalStoreNode *)newValuesForObjectWithID:(NSManagedObjectID *)objectID
+                                         withContext:(NSManagedObjectContext *)context
+                                               error:(NSError *__autoreleasing *)error
+{
+    [self enqueueNextPageIfNeededForObjectWithID:objectID withContext:context];
+    
+    NSDictionary *attributeValues = nil;
+    NSArray *attributeKeys = [[self mappingForEntity:[objectID entity]] attributeNames];
+    
+    // Objects already known to the identity map are looked up by ID, and rows read recently are served from the row cache without going to the store
+    NSManagedObjectID *backingObjectID = [_backingObjectIDByObjectID objectForKey:objectID];
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    __block NSDictionary *row = nil;
+    __block NSError *fetchError = nil;
+    [backingContext performBlockAndWait:^{
+        row = (backingObjectID != nil) ? [_propertyValuesCache objectForKey:backingObjectID] : nil;
+        if (row) {
+            return;
+        }
+        
+        NSManagedObject *backingObject = (backingObjectID != nil) ? [backingContext existingObjectWithID:backingObjectID error:nil] : nil;
+        if (!backingObject) {
+            NSFetchRequest *fetchRequest = [_backingPersistentStoreCoordinator.managedObjectModel fetchRequestFromTemplateWithName:AFBackingObjectFetchRequestTemplateName([objectID entity]) substitutionVariables:[NSDictionary dictionaryWithObject:[self referenceObjectForObjectID:objectID] forKey:kAFIncrementalStoreResourceIdentifierSubstitutionVariable]];
+            fetchRequest.includesSubentities = NO;
+            fetchRequest.returnsObjectsAsFaults = NO;
             
-            AFHTTPRequestOperation *operation = [self.HTTPClient HTTPRequestOperationWithRequest:request success:^(AFHTTPRequestOperation *operation, id responseObject) {
-                id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
-                
-                NSArray *representations = nil;
-                if ([representationOrArrayOfRepresentations isKindOfClass:[NSArray class]]) {
-                    representations = representationOrArrayOfRepresentations;
-                } else {
-                    representations = [NSArray arrayWithObject:representationOrArrayOfRepresentations];
+            backingObject = [[backingContext executeFetchRequest:fetchRequest error:&fetchError] lastObject];
+            if (backingObject) {
+                [self cacheBackingObjectIDsOfBackingObjects:[NSArray arrayWithObject:backingObject]];
+            }
+        }
+        
+        if (backingObject) {
+            NSMutableDictionary *mutableAttributeValues = [NSMutableDictionary dictionaryWithCapacity:[attributeKeys count]];
+            for (NSString *key in attributeKeys) {
+                [mutableAttributeValues setValue:[backingObject valueForKey:key] forKey:key];
+            }
+            
+            NSMutableDictionary *mutableRelationshipValues = [NSMutableDictionary dictionary];
+            AFEntityMapping *mapping = [self mappingForEntity:[objectID entity]];
+            [mapping.relationshipsByName enumerateKeysAndObjectsUsingBlock:^(NSString *relationshipName, NSRelationshipDescription *relationship, __unused BOOL *stop) {
+                if ([mapping.toManyRelationshipNames containsObject:relationshipName]) {
+                    return;
                 }
                 
-                [childContext performBlock:^{
-                    NSManagedObject *managedObject = [childContext existingObjectWithID:[self objectIDForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]] error:nil];
-                    NSManagedObject *backingObject = [backingContext existingObjectWithID:[self objectIDForBackingObjectForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]] error:nil];
-
-                    id mutableBackingRelationshipObjects = [relationship isOrdered] ? [NSMutableOrderedSet orderedSetWithCapacity:[representations count]] : [NSMutableSet setWithCapacity:[representations count]];
-                    id mutableManagedRelationshipObjects = [relationship isOrdered] ? [NSMutableOrderedSet orderedSetWithCapacity:[representations count]] : [NSMutableSet setWithCapacity:[representations count]];
+                NSManagedObject *backingRelationshipObject = [backingObject valueForKey:relationshipName];
+                NSString *resourceIdentifier = [backingRelationshipObject valueForKey:kAFIncrementalStoreResourceIdentifierAttributeName];
+                if (resourceIdentifier) {
+                    [mutableRelationshipValues setObject:[self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:resourceIdentifier] forKey:relationshipName];
+                }
+            }];
+            
+            NSMutableDictionary *mutableRow = [NSMutableDictionary dictionaryWithCapacity:4];
+            [mutableRow setObject:mutableAttributeValues forKey:kAFIncrementalStoreRowAttributeValuesKey];
+            [mutableRow setObject:mutableRelationshipValues forKey:kAFIncrementalStoreRowRelationshipValuesKey];
+            [mutableRow setObject:[NSNumber numberWithUnsignedLongLong:MAX([[backingObject valueForKey:kAFIncrementalStoreVersionAttributeName] unsignedLongLongValue], (uint64_t)1)] forKey:kAFIncrementalStoreRowVersionKey];
+            [mutableRow setValue:[backingObject valueForKey:kAFIncrementalStoreLastFetchedDateAttributeName] forKey:kAFIncrementalStoreRowLastFetchedDateKey];
+            row = mutableRow;
+            
+            [_propertyValuesCache setObject:row forKey:backingObject.objectID cost:AFEstimatedCostOfValue(row)];
+        }
+    }];
+    
+    if (fetchError && error) {
+        *error = fetchError;
+    }
+    attributeValues = [row objectForKey:kAFIncrementalStoreRowAttributeValuesKey] ?: [NSDictionary dictionary];
+    uint64_t version = row ? [[row objectForKey:kAFIncrementalStoreRowVersionKey] unsignedLongLongValue] : 1;
+    NSDate *lastFetchedDate = [row objectForKey:kAFIncrementalStoreRowLastFetchedDateKey];
+    
+    // To-one relationships that are already stored, and that the HTTP client would not refresh, are included in the node, so that traversing them doesn't require a separate call to `-newValueForRelationship:forObjectWithID:withContext:error:`
+    NSMutableDictionary *mutableValues = [attributeValues mutableCopy];
+    NSDictionary *relationshipsByName = [[self mappingForEntity:[objectID entity]] relationshipsByName];
+    [[row objectForKey:kAFIncrementalStoreRowRelationshipValuesKey] enumerateKeysAndObjectsUsingBlock:^(NSString *relationshipName, NSManagedObjectID *relationshipObjectID, __unused BOOL *stop) {
+        if ([self.HTTPClient respondsToSelector:@selector(shouldFetchRemoteValuesForRelationship:forObjectWithID:inManagedObjectContext:)] && [self.HTTPClient shouldFetchRemoteValuesForRelationship:[relationshipsByName objectForKey:relationshipName] forObjectWithID:objectID inManagedObjectContext:context]) {
+            return;
+        }
+        
+        [mutableValues setObject:relationshipObjectID forKey:relationshipName];
+    }];
 
-                    NSEntityDescription *entity = relationship.destinationEntity;
+    NSIncrementalStoreNode *node = [[NSIncrementalStoreNode alloc] initWithObjectID:objectID withValues:mutableValues version:version];
+    
+    // Import and outbound contexts read the values the store already has, and never request them again, as do contexts reading values that are still fresh
+    BOOL isImportContext = [[context.userInfo objectForKey:kAFIncrementalStoreImportContextKey] boolValue];
+    if (!isImportContext && ![self isFreshLastFetchedDate:lastFetchedDate forEntity:[objectID entity]] && [self.HTTPClient respondsToSelector:@selector(shouldFetchRemoteAttributeValuesForObjectWithID:inManagedObjectContext:)] && [self.HTTPClient shouldFetchRemoteAttributeValuesForObjectWithID:objectID inManagedObjectContext:context]) {
+        if ([self.HTTPClient respondsToSelector:@selector(requestWithMethod:pathForObjectsWithIDs:withContext:)]) {
+            [self enqueueRemoteAttributeValuesFetchForObjectWithID:objectID withContext:context];
+        } else if (attributeValues) {
+            NSManagedObjectContext *backingManagedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+            backingManagedObjectContext.parentContext = context;
+            backingManagedObjectContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
+            [backingManagedObjectContext.userInfo setObject:[NSNumber numberWithBool:YES] forKey:kAFIncrementalStoreImportContextKey];
+            
+            NSURLRequest *request = [self.HTTPClient requestWithMethod:@"GET" pathForObjectWithID:objectID withContext:context];
+            
+            if ([request URL]) {
+                CFAbsoluteTime requestStartTime = CFAbsoluteTimeGetCurrent();
+                [self enqueueHTTPRequestOperationWithRequest:request queuePriority:NSOperationQueuePriorityLow forFaultsOfObjectsWithIDs:[NSArray arrayWithObject:objectID] success:^(AFHTTPRequestOperation *operation, NSDictionary *representation) {
+                    [self didCompletePhase:AFIncrementalStoreRequestPhase ofEntity:[objectID entity] withURL:[request URL] startTime:requestStartTime numberOfObjects:0];
                     
-                    for (NSDictionary *representation in representations) {
-                        NSString *relationshipResourceIdentifier = [self.HTTPClient resourceIdentifierForRepresentation:representation ofEntity:entity fromResponse:operation.response];
-
-                        NSManagedObjectID *relationshipObjectID = [self objectIDForBackingObjectForEntity:relationship.destinationEntity withResourceIdentifier:relationshipResourceIdentifier];
-                        NSDictionary *relationshipAttributes = [self.HTTPClient attributesForRepresentation:representation ofEntity:entity fromResponse:operation.response];
+                    [backingManagedObjectContext performBlock:^{
+                        NSManagedObject *managedObject = [backingManagedObjectContext existingObjectWithID:objectID error:nil];
                         
-                        NSManagedObject *backingRelationshipObject = (relationshipObjectID != nil) ? [backingContext existingObjectWithID:relationshipObjectID error:nil] : [NSEntityDescription insertNewObjectForEntityForName:[relationship.destinationEntity name] inManagedObjectContext:backingContext];
-                        [backingRelationshipObject setValuesForKeysWithDictionary:relationshipAttributes];
-                        [mutableBackingRelationshipObjects addObject:backingRelationshipObject];
-
-                        NSManagedObject *managedRelationshipObject = [childContext existingObjectWithID:[self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:relationshipResourceIdentifier] error:nil];
-                        [managedRelationshipObject setValuesForKeysWithDictionary:relationshipAttributes];
-                        [mutableManagedRelationshipObjects addObject:managedRelationshipObject];
-                        if (relationshipObjectID == nil) {
-                            [childContext insertObject:managedRelationshipObject];
+                        NSMutableDictionary *mutablePropertyValues = [attributeValues mutableCopy];
+                        [mutablePropertyValues addEntriesFromDictionary:[self.HTTPClient attributesForRepresentation:representation ofEntity:managedObject.entity fromResponse:operation.response]];
+                        AFSetChangedValuesForKeysWithDictionary(managedObject, mutablePropertyValues);
+                        
+                        NSSet *updatedManagedObjects = [backingManagedObjectContext updatedObjects];
+                        NSError *saveError = nil;
+                        if (![backingManagedObjectContext save:&saveError]) {
+                            [self didFailWithError:saveError];
+                        } else {
+                            [self enqueueMergeOfInsertedObjects:nil updatedObjects:updatedManagedObjects deletedObjects:nil intoContext:context];
                         }
-                    }
-                    
-                    if ([relationship isToMany]) {
-                        [managedObject setValue:mutableManagedRelationshipObjects forKey:relationship.name];
-                        [backingObject setValue:mutableBackingRelationshipObjects forKey:relationship.name];
-                    } else {
-                        [managedObject setValue:[mutableManagedRelationshipObjects anyObject] forKey:relationship.name];
-                        [backingObject setValue:[mutableBackingRelationshipObjects anyObject] forKey:relationship.name];
-                    }
-                
-                    if (![backingContext save:error] || ![childContext save:error]) {
-                        NSLog(@"Error: %@", *error);
-                    }
+                    }];
+                } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+                    [self didFailWithError:error];
                 }];
-            } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
-                NSLog(@"Error: %@, %@", operation, error);
-            }];
+            }
+        }
+    }
+    
+    return node;
+}
+
+- (void)enqueueRemoteAttributeValuesFetchForObjectWithID:(NSManagedObjectID *)objectID
+                                             withContext:(NSManagedObjectContext *)context
+{
+    NSValue *contextKey = [NSValue valueWithNonretainedObject:context];
+    __block BOOL shouldScheduleFetch = NO;
+    dispatch_sync(_attributeFaultBatchingQueue, ^{
+        NSMutableOrderedSet *mutableObjectIDs = [_pendingAttributeFaultObjectIDsByContext objectForKey:contextKey];
+        if (!mutableObjectIDs) {
+            mutableObjectIDs = [NSMutableOrderedSet orderedSet];
+            [_pendingAttributeFaultObjectIDsByContext setObject:mutableObjectIDs forKey:contextKey];
+            shouldScheduleFetch = YES;
+        }
+        
+        [mutableObjectIDs addObject:objectID];
+    });
+    
+    // Faults fired during the current pass on the queue of the context are collected, and fetched together once that pass completes
+    if (shouldScheduleFetch) {
+        [context performBlock:^{
+            [self fetchRemoteAttributeValuesForPendingObjectsWithContext:context];
+        }];
+    }
+}
+
+- (void)fetchRemoteAttributeValuesForPendingObjectsWithContext:(NSManagedObjectContext *)context {
+    NSValue *contextKey = [NSValue valueWithNonretainedObject:context];
+    __block NSOrderedSet *objectIDs = nil;
+    dispatch_sync(_attributeFaultBatchingQueue, ^{
+        objectIDs = [_pendingAttributeFaultObjectIDsByContext objectForKey:contextKey];
+        [_pendingAttributeFaultObjectIDsByContext removeObjectForKey:contextKey];
+    });
+    
+    NSMutableDictionary *mutableObjectIDsByEntityName = [NSMutableDictionary dictionary];
+    for (NSManagedObjectID *objectID in objectIDs) {
+        NSMutableArray *mutableObjectIDs = [mutableObjectIDsByEntityName objectForKey:[[objectID entity] name]];
+        if (!mutableObjectIDs) {
+            mutableObjectIDs = [NSMutableArray array];
+            [mutableObjectIDsByEntityName setObject:mutableObjectIDs forKey:[[objectID entity] name]];
+        }
+        [mutableObjectIDs addObject:objectID];
+    }
+    
+    for (NSString *entityName in mutableObjectIDsByEntityName) {
+        NSArray *entityObjectIDs = [mutableObjectIDsByEntityName objectForKey:entityName];
+        NSEntityDescription *entity = [[entityObjectIDs lastObject] entity];
+        
+        NSURLRequest *request = [self.HTTPClient requestWithMethod:@"GET" pathForObjectsWithIDs:entityObjectIDs withContext:context];
+        if (![request URL]) {
+            continue;
+        }
+        
+        CFAbsoluteTime requestStartTime = CFAbsoluteTimeGetCurrent();
+        [self enqueueHTTPRequestOperationWithRequest:request queuePriority:NSOperationQueuePriorityLow forFaultsOfObjectsWithIDs:entityObjectIDs success:^(AFHTTPRequestOperation *operation, id responseObject) {
+            [self didCompletePhase:AFIncrementalStoreRequestPhase ofEntity:entity withURL:[request URL] startTime:requestStartTime numberOfObjects:0];
             
-            operation.successCallbackQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0);
-            [self.HTTPClient enqueueHTTPRequestOperation:operation];
+            CFAbsoluteTime mappingStartTime = CFAbsoluteTimeGetCurrent();
+            id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
+            
+            NSArray *representations = nil;
+            if ([representationOrArrayOfRepresentations isKindOfClass:[NSArray class]]) {
+                representations = representationOrArrayOfRepresentations;
+            } else {
+                representations = [NSArray arrayWithObject:representationOrArrayOfRepresentations];
+            }
+            [self didCompletePhase:AFIncrementalStoreResponseMappingPhase ofEntity:entity withURL:[request URL] startTime:mappingStartTime numberOfObjects:[representations count]];
+            
+            [self importRepresentations:representations ofEntity:entity fromResponse:operation.response withContext:context];
+        } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+            [self didFailWithError:error];
+        }];
+    }
+}
+
+- (void)enqueueMergeOfInsertedObjects:(NSSet *)insertedObjects
+                       updatedObjects:(NSSet *)updatedObjects
+                       deletedObjects:(NSSet *)deletedObjects
+                          intoContext:(NSManagedObjectContext *)context
+{
+    if ([insertedObjects count] == 0 && [updatedObjects count] == 0 && [deletedObjects count] == 0) {
+        return;
+    }
+    
+    NSValue *contextKey = [NSValue valueWithNonretainedObject:context];
+    __block BOOL shouldScheduleMerge = NO;
+    dispatch_sync(_changeMergingQueue, ^{
+        NSDictionary *pendingChanges = [_pendingChangesByContext objectForKey:contextKey];
+        if (!pendingChanges) {
+            pendingChanges = [NSDictionary dictionaryWithObjectsAndKeys:[NSMutableSet set], NSInsertedObjectsKey, [NSMutableSet set], NSUpdatedObjectsKey, [NSMutableSet set], NSDeletedObjectsKey, nil];
+            [_pendingChangesByContext setObject:pendingChanges forKey:contextKey];
+            shouldScheduleMerge = YES;
         }
+        
+        NSMutableSet *mutableInsertedObjectIDs = [pendingChanges objectForKey:NSInsertedObjectsKey];
+        NSMutableSet *mutableUpdatedObjectIDs = [pendingChanges objectForKey:NSUpdatedObjectsKey];
+        NSMutableSet *mutableDeletedObjectIDs = [pendingChanges objectForKey:NSDeletedObjectsKey];
+        [mutableInsertedObjectIDs unionSet:[insertedObjects valueForKey:@"objectID"]];
+        [mutableUpdatedObjectIDs unionSet:[updatedObjects valueForKey:@"objectID"]];
+        
+        // An object deleted by a later import supersedes any earlier insertion or update of it
+        NSSet *deletedObjectIDs = [deletedObjects valueForKey:@"objectID"];
+        [mutableInsertedObjectIDs minusSet:deletedObjectIDs];
+        [mutableUpdatedObjectIDs minusSet:deletedObjectIDs];
+        [mutableDeletedObjectIDs unionSet:deletedObjectIDs];
+    });
+    
+    // Changes saved by every import that finishes before the queue of the context gets to it are merged as a single batch
+    if (shouldScheduleMerge) {
+        [context performBlock:^{
+            [self mergePendingChangesIntoContext:context];
+        }];
     }
+}
+
+- (void)mergePendingChangesIntoContext:(NSManagedObjectContext *)context {
+    NSValue *contextKey = [NSValue valueWithNonretainedObject:context];
+    __block NSDictionary *pendingChanges = nil;
+    dispatch_sync(_changeMergingQueue, ^{
+        pendingChanges = [_pendingChangesByContext objectForKey:contextKey];
+        [_pendingChangesByContext removeObjectForKey:contextKey];
+    });
     
-    NSManagedObjectID *backingObjectID = [self objectIDForBackingObjectForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]];
-    NSManagedObject *backingObject = (backingObjectID == nil) ? nil : [[self backingManagedObjectContext] existingObjectWithID:backingObjectID error:nil];
+    // Only objects registered with the context have anything to merge; the rest are faulted in with their current values when they are next accessed
+    NSMutableDictionary *mutableUserInfo = [NSMutableDictionary dictionaryWithCapacity:[pendingChanges count]];
+    __block NSUInteger numberOfObjects = 0;
+    [pendingChanges enumerateKeysAndObjectsUsingBlock:^(id key, NSSet *objectIDs, __unused BOOL *stop) {
+        NSMutableSet *mutableObjects = [NSMutableSet setWithCapacity:[objectIDs count]];
+        for (NSManagedObjectID *objectID in objectIDs) {
+            NSManagedObject *managedObject = [context objectRegisteredForID:objectID];
+            if (managedObject) {
+                [mutableObjects addObject:managedObject];
+            }
+        }
+        
+        [mutableUserInfo setObject:mutableObjects forKey:key];
+        numberOfObjects += [mutableObjects count];
+    }];
     
-    if (backingObject && ![backingObject hasChanges]) {
-        id backingRelationshipObject = [backingObject valueForKeyPath:relationship.name];
-        if ([relationship isToMany]) {
-            NSMutableArray *mutableObjects = [NSMutableArray arrayWithCapacity:[backingRelationshipObject count]];
-            for (NSString *resourceIdentifier in [backingRelationshipObject valueForKeyPath:kAFIncrementalStoreResourceIdentifierAttributeName]) {
+    CFAbsoluteTime mergeStartTime = CFAbsoluteTimeGetCurrent();
+    [context mergeChangesFromContextDidSaveNotification:[NSNotification notificationWithName:NSManagedObjectContextDidSaveNotification object:nil userInfo:mutableUserInfo]];
+    [self didCompletePhase:AFIncrementalStoreMergePhase ofEntity:nil withURL:nil startTime:mergeStartTime numberOfObjects:numberOfObjects];
+}
+
+- (void)enqueueRemoteFetchForRelationship:(NSRelationshipDescription *)relationship
+                          ofObjectWithID:(NSManagedObjectID *)objectID
+                             withContext:(NSManagedObjectContext *)context
+                              completion:(void (^)(void))completion
+{
+    void (^completionCallback)(void) = completion ? [completion copy] : [^{} copy];
+    
+    NSURLRequest *request = [self.HTTPClient requestWithMethod:@"GET" pathForRelationship:relationship forObjectWithID:objectID withContext:context];
+    if (![request URL] || [self isFreshLastFetchedDate:[self lastFetchedDateForKey:AFRequestSignature(request) ofEntity:relationship.destinationEntity] forEntity:relationship.destinationEntity]) {
+        completionCallback();
+        return;
+    }
+    
+    CFAbsoluteTime requestStartTime = CFAbsoluteTimeGetCurrent();
+    [self enqueueHTTPRequestOperationWithRequest:request queuePriority:NSOperationQueuePriorityLow forFaultsOfObjectsWithIDs:[NSArray arrayWithObject:objectID] success:^(AFHTTPRequestOperation *operation, id responseObject) {
+        [self didCompletePhase:AFIncrementalStoreRequestPhase ofEntity:relationship.destinationEntity withURL:[request URL] startTime:requestStartTime numberOfObjects:0];
+        
+        CFAbsoluteTime mappingStartTime = CFAbsoluteTimeGetCurrent();
+        id representationOrArrayOfRepresentations = [self.HTTPClient representationOrArrayOfRepresentationsFromResponseObject:responseObject];
+        
+        NSArray *representations = nil;
+        if ([representationOrArrayOfRepresentations isKindOfClass:[NSArray class]]) {
+            representations = representationOrArrayOfRepresentations;
+        } else {
+            representations = [NSArray arrayWithObject:representationOrArrayOfRepresentations];
+        }
+        [self didCompletePhase:AFIncrementalStoreResponseMappingPhase ofEntity:relationship.destinationEntity withURL:[request URL] startTime:mappingStartTime numberOfObjects:[representations count]];
+        
+        [self importRepresentations:representations ofEntity:relationship.destinationEntity deletedResourceIdentifiers:nil forRelationship:relationship ofObjectWithID:objectID fromResponse:operation.response withContext:context completion:^(BOOL didImportAllBatches) {
+            if (didImportAllBatches) {
+                [self setLastFetchedDateForKey:AFRequestSignature(request) ofEntity:relationship.destinationEntity];
+            }
+            
+            completionCallback();
+        }];
+    } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
+        [self didFailWithError:error];
+        completionCallback();
+    }];
+}
+
+- (id)newValueForRelationship:(NSRelationshipDescription *)relationship
+              forObjectWithID:(NSManagedObjectID *)objectID
+                  withContext:(NSManagedObjectContext *)context
+                        error:(NSError *__autoreleasing *)error
+{
+    if (![[context.userInfo objectForKey:kAFIncrementalStoreImportContextKey] boolValue] && [self.HTTPClient respondsToSelector:@selector(shouldFetchRemoteValuesForRelationship:forObjectWithID:inManagedObjectContext:)] && [self.HTTPClient shouldFetchRemoteValuesForRelationship:relationship forObjectWithID:objectID inManagedObjectContext:context]) {
+        if (![[context existingObjectWithID:objectID error:nil] hasChanges]) {
+            [self enqueueRemoteFetchForRelationship:relationship ofObjectWithID:objectID withContext:context completion:nil];
+        }
+    }
+    
+    NSManagedObjectID *backingObjectID = [self objectIDForBackingObjectForEntity:[objectID entity] withResourceIdentifier:[self referenceObjectForObjectID:objectID]];
+    NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+    __block id value = nil;
+    [backingContext performBlockAndWait:^{
+        NSDictionary *valuesByRelationshipName = (backingObjectID == nil) ? nil : [_relationshipsCache objectForKey:backingObjectID];
+        value = [valuesByRelationshipName objectForKey:relationship.name];
+        if (value) {
+            return;
+        }
+        
+        NSManagedObject *backingObject = (backingObjectID == nil) ? nil : [backingContext existingObjectWithID:backingObjectID error:nil];
+        
+        if (backingObject && ![backingObject hasChanges]) {
+            id backingRelationshipObject = [backingObject valueForKeyPath:relationship.name];
+            if ([relationship isToMany]) {
+                NSMutableArray *mutableObjects = [NSMutableArray arrayWithCapacity:[backingRelationshipObject count]];
+                for (NSString *resourceIdentifier in [backingRelationshipObject valueForKeyPath:kAFIncrementalStoreResourceIdentifierAttributeName]) {
+                    NSManagedObjectID *objectID = [self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:resourceIdentifier];
+                    [mutableObjects addObject:objectID];
+                }
+                
+                value = mutableObjects;
+            } else {
+                NSString *resourceIdentifier = [backingRelationshipObject valueForKeyPath:kAFIncrementalStoreResourceIdentifierAttributeName];
                 NSManagedObjectID *objectID = [self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:resourceIdentifier];
-                [mutableObjects addObject:objectID];
+                value = objectID ?: [NSNull null];
             }
-                        
-            return mutableObjects;            
-        } else {
-            NSString *resourceIdentifier = [backingRelationshipObject valueForKeyPath:kAFIncrementalStoreResourceIdentifierAttributeName];
-            NSManagedObjectID *objectID = [self objectIDForEntity:relationship.destinationEntity withResourceIdentifier:resourceIdentifier];
-            return objectID ?: [NSNull null];
         }
+        
+        if (value) {
+            NSMutableDictionary *mutableValuesByRelationshipName = [valuesByRelationshipName mutableCopy] ?: [NSMutableDictionary dictionary];
+            [mutableValuesByRelationshipName setObject:value forKey:relationship.name];
+            [_relationshipsCache setObject:mutableValuesByRelationshipName forKey:backingObjectID cost:AFEstimatedCostOfValue(mutableValuesByRelationshipName)];
+        }
+    }];
+    
+    if (value) {
+        return value;
     } else {
         if ([relationship isToMany]) {
             return [NSArray array];
@@ -446,18 +2523,324 @@ static NSString * const kAFIncrementalStoreResourceIdentifierAttributeName = @"_
 
 #pragma mark - NSIncrementalStore
 
+- (NSArray *)obtainPermanentIDsForObjects:(NSArray *)array
+                                    error:(NSError *__autoreleasing *)error
+{
+    // Objects inserted locally are identified by a unique local resource identifier until the server assigns them one
+    NSMutableArray *mutablePermanentIDs = [NSMutableArray arrayWithCapacity:[array count]];
+    for (NSManagedObject *managedObject in array) {
+        NSString *resourceIdentifier = [kAFIncrementalStoreLocalResourceIdentifierPrefix stringByAppendingString:[[NSProcessInfo processInfo] globallyUniqueString]];
+        [mutablePermanentIDs addObject:[self newObjectIDForEntity:managedObject.entity referenceObject:resourceIdentifier]];
+    }
+    
+    return mutablePermanentIDs;
+}
+
+- (id)referenceObjectForObjectID:(NSManagedObjectID *)objectID {
+    id referenceObject = [super referenceObjectForObjectID:objectID];
+    if ([referenceObject isKindOfClass:[NSString class]] && [referenceObject hasPrefix:kAFIncrementalStoreLocalResourceIdentifierPrefix]) {
+        referenceObject = [[self metadataValueForKey:kAFIncrementalStoreResourceIdentifierAliasesMetadataKey] objectForKey:referenceObject] ?: referenceObject;
+    }
+    
+    return referenceObject;
+}
+
+- (void)prefetchResultsOfFetchRequests:(NSArray *)fetchRequests
+                           completion:(void (^)(void))completion
+{
+    // Results are imported through a context of their own, which is never saved, so that they land in the backing store without being merged into, or displayed by, any of the application's contexts
+    NSManagedObjectContext *prefetchContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    prefetchContext.persistentStoreCoordinator = self.persistentStoreCoordinator;
+    [prefetchContext.userInfo setObject:[NSNumber numberWithBool:YES] forKey:kAFIncrementalStoreImportContextKey];
+    
+    BOOL isSynchronizedIncrementally = [self.HTTPClient respondsToSelector:@selector(requestForChangesToEntity:sinceSyncToken:withContext:)] && [self.HTTPClient respondsToSelector:@selector(syncTokenFromResponseObject:ofEntity:fromResponse:)] && [self.HTTPClient respondsToSelector:@selector(resourceIdentifiersOfDeletedResourcesFromResponseObject:ofEntity:fromResponse:)];
+    
+    dispatch_group_t group = dispatch_group_create();
+    for (NSFetchRequest *originalFetchRequest in fetchRequests) {
+        NSFetchRequest *fetchRequest = [originalFetchRequest copy];
+        if (!fetchRequest.entity) {
+            fetchRequest.entity = [[self.persistentStoreCoordinator.managedObjectModel entitiesByName] objectForKey:fetchRequest.entityName];
+        }
+        
+        dispatch_group_enter(group);
+        void (^fetchCompletion)(void) = ^{
+            NSArray *relationshipKeyPaths = fetchRequest.relationshipKeyPathsForPrefetching;
+            if ([relationshipKeyPaths count] == 0) {
+                dispatch_group_leave(group);
+                return;
+            }
+            
+            NSManagedObjectContext *backingContext = [self backingManagedObjectContext];
+            __block NSArray *backingObjectIDs = nil;
+            [backingContext performBlockAndWait:^{
+                NSFetchRequest *backingFetchRequest = [fetchRequest copy];
+                backingFetchRequest.entity = [NSEntityDescription entityForName:fetchRequest.entityName inManagedObjectContext:backingContext];
+                backingFetchRequest.resultType = NSManagedObjectIDResultType;
+                backingFetchRequest.relationshipKeyPathsForPrefetching = nil;
+                backingObjectIDs = [backingContext executeFetchRequest:backingFetchRequest error:nil];
+            }];
+            
+            NSArray *objectIDs = [self objectIDsForBackingObjectIDs:backingObjectIDs ofEntity:fetchRequest.entity batchSize:0 error:nil];
+            [self prefetchRelationshipKeyPaths:relationshipKeyPaths ofObjectsWithIDs:objectIDs ofEntity:fetchRequest.entity withContext:prefetchContext completion:^{
+                dispatch_group_leave(group);
+            }];
+        };
+        
+        if (isSynchronizedIncrementally) {
+            [self enqueueRemoteChangesFetchForEntity:fetchRequest.entity withContext:prefetchContext completion:fetchCompletion];
+        } else {
+            [self enqueueRemoteFetchRequest:fetchRequest withPageCursor:nil withContext:prefetchContext completion:fetchCompletion];
+        }
+    }
+    
+    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        // Imports save into the context, which is held on to until all of them have completed, and then emptied on its own queue
+        [prefetchContext performBlock:^{
+            [prefetchContext reset];
+            
+            if (completion) {
+                dispatch_async(dispatch_get_main_queue(), completion);
+            }
+        }];
+    });
+#if !OS_OBJECT_USE_OBJC
+    dispatch_release(group);
+#endif
+}
+
+- (void)prefetchRelationshipKeyPaths:(NSArray *)keyPaths
+                    ofObjectsWithIDs:(NSArray *)objectIDs
+                            ofEntity:(NSEntityDescription *)entity
+                         withContext:(NSManagedObjectContext *)context
+                          completion:(void (^)(void))completion
+{
+    // Key paths sharing a first relationship are fetched once, and followed on with the remainder of each
+    NSMutableDictionary *mutableRemainingKeyPathsByRelationshipName = [NSMutableDictionary dictionary];
+    for (NSString *keyPath in keyPaths) {
+        NSArray *components = [keyPath componentsSeparatedByString:@"."];
+        NSString *relationshipName = [components objectAtIndex:0];
+        NSMutableArray *mutableRemainingKeyPaths = [mutableRemainingKeyPathsByRelationshipName objectForKey:relationshipName];
+        if (!mutableRemainingKeyPaths) {
+            mutableRemainingKeyPaths = [NSMutableArray array];
+            [mutableRemainingKeyPathsByRelationshipName setObject:mutableRemainingKeyPaths forKey:relationshipName];
+        }
+        
+        if ([components count] > 1) {
+            [mutableRemainingKeyPaths addObject:[[components subarrayWithRange:NSMakeRange(1, [components count] - 1)] componentsJoinedByString:@"."]];
+        }
+    }
+    
+    BOOL shouldFetchRemoteValues = [self.HTTPClient respondsToSelector:@selector(shouldFetchRemoteValuesForRelationship:forObjectWithID:inManagedObjectContext:)];
+    
+    dispatch_group_t group = dispatch_group_create();
+    [mutableRemainingKeyPathsByRelationshipName enumerateKeysAndObjectsUsingBlock:^(NSString *relationshipName, NSArray *remainingKeyPaths, __unused BOOL *stop) {
+        NSRelationshipDescription *relationship = [[entity relationshipsByName] objectForKey:relationshipName];
+        if (!relationship) {
+            return;
+        }
+        
+        dispatch_group_enter(group);
+        dispatch_group_t relationshipGroup = dispatch_group_create();
+        [context performBlockAndWait:^{
+            for (NSManagedObjectID *objectID in objectIDs) {
+                if (![objectID isKindOfClass:[NSManagedObjectID class]] || !shouldFetchRemoteValues || ![self.HTTPClient shouldFetchRemoteValuesForRelationship:relationship forObjectWithID:objectID inManagedObjectContext:context]) {
+                    continue;
+                }
+                
+                dispatch_group_enter(relationshipGroup);
+                [self enqueueRemoteFetchForRelationship:relationship ofObjectWithID:objectID withContext:context completion:^{
+                    dispatch_group_leave(relationshipGroup);
+                }];
+            }
+        }];
+        
+        dispatch_group_notify(relationshipGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            if ([remainingKeyPaths count] == 0) {
+                dispatch_group_leave(group);
+                return;
+            }
+            
+            // Destination objects are read from the backing store alone, as the context is an import context
+            NSMutableArray *mutableDestinationObjectIDs = [NSMutableArray array];
+            [context performBlockAndWait:^{
+                for (NSManagedObjectID *objectID in objectIDs) {
+                    if (![objectID isKindOfClass:[NSManagedObjectID class]]) {
+                        continue;
+                    }
+                    
+                    id value = [self newValueForRelationship:relationship forObjectWithID:objectID withContext:context error:nil];
+                    if ([value isKindOfClass:[NSArray class]]) {
+                        [mutableDestinationObjectIDs addObjectsFromArray:value];
+                    } else if ([value isKindOfClass:[NSManagedObjectID class]]) {
+                        [mutableDestinationObjectIDs addObject:value];
+                    }
+                }
+            }];
+            
+            [self prefetchRelationshipKeyPaths:remainingKeyPaths ofObjectsWithIDs:mutableDestinationObjectIDs ofEntity:relationship.destinationEntity withContext:context completion:^{
+                dispatch_group_leave(group);
+            }];
+        });
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(relationshipGroup);
+#endif
+    }];
+    
+    dispatch_group_notify(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        if (completion) {
+            completion();
+        }
+    });
+#if !OS_OBJECT_USE_OBJC
+    dispatch_release(group);
+#endif
+}
+
+- (void)cancelPendingRemoteFaultsForObjectsWithIDs:(NSArray *)objectIDs {
+    dispatch_sync(_attributeFaultBatchingQueue, ^{
+        for (NSMutableOrderedSet *mutableObjectIDs in [_pendingAttributeFaultObjectIDsByContext allValues]) {
+            [mutableObjectIDs removeObjectsInArray:objectIDs];
+        }
+    });
+    
+    NSMutableArray *mutableOperations = [NSMutableArray array];
+    dispatch_sync(_requestCoalescingQueue, ^{
+        for (NSManagedObjectID *objectID in objectIDs) {
+            for (NSString *requestSignature in [_faultRequestSignaturesByObjectID objectForKey:objectID]) {
+                NSMutableSet *mutableFaultObjectIDs = [_faultObjectIDsByRequestSignature objectForKey:requestSignature];
+                [mutableFaultObjectIDs removeObject:objectID];
+                
+                AFHTTPRequestOperation *operation = [_HTTPRequestOperationsByRequestSignature objectForKey:requestSignature];
+                if (mutableFaultObjectIDs && [mutableFaultObjectIDs count] == 0 && operation && ![operation isExecuting]) {
+                    [mutableOperations addObject:operation];
+                }
+            }
+            [_faultRequestSignaturesByObjectID removeObjectForKey:objectID];
+        }
+    });
+    
+    // Cancelled operations complete with an error, which releases the callbacks and signatures attached to them
+    [mutableOperations makeObjectsPerformSelector:@selector(cancel)];
+}
+
 - (void)managedObjectContextDidRegisterObjectsWithIDs:(NSArray *)objectIDs {
     [super managedObjectContextDidRegisterObjectsWithIDs:objectIDs];
+    
+    NSMutableArray *mutableResourceIdentifiers = [NSMutableArray arrayWithCapacity:[objectIDs count]];
     for (NSManagedObjectID *objectID in objectIDs) {
-        [_registeredObjectIDsByResourceIdentifier setObject:objectID forKey:[self referenceObjectForObjectID:objectID]];
+        [mutableResourceIdentifiers addObject:[self referenceObjectForObjectID:objectID]];
     }
+    
+    dispatch_barrier_async(_registeredObjectIDsQueue, ^{
+        [objectIDs enumerateObjectsUsingBlock:^(NSManagedObjectID *objectID, NSUInteger idx, __unused BOOL *stop) {
+            NSString *entityName = AFRootEntityName([objectID entity]);
+            NSMutableDictionary *mutableObjectIDsByResourceIdentifier = [_registeredObjectIDsByResourceIdentifierByEntityName objectForKey:entityName];
+            if (!mutableObjectIDsByResourceIdentifier) {
+                mutableObjectIDsByResourceIdentifier = [NSMutableDictionary dictionary];
+                [_registeredObjectIDsByResourceIdentifierByEntityName setObject:mutableObjectIDsByResourceIdentifier forKey:entityName];
+            }
+            
+            [mutableObjectIDsByResourceIdentifier setObject:objectID forKey:[mutableResourceIdentifiers objectAtIndex:idx]];
+            [_registeredObjectIDs addObject:objectID];
+        }];
+    });
 }
 
 - (void)managedObjectContextDidUnregisterObjectsWithIDs:(NSArray *)objectIDs {
     [super managedObjectContextDidUnregisterObjectsWithIDs:objectIDs];
+    
+    NSMutableArray *mutableResourceIdentifiers = [NSMutableArray arrayWithCapacity:[objectIDs count]];
     for (NSManagedObjectID *objectID in objectIDs) {
-        [_registeredObjectIDsByResourceIdentifier removeObjectForKey:[self referenceObjectForObjectID:objectID]];
-    }    
+        [mutableResourceIdentifiers addObject:[self referenceObjectForObjectID:objectID]];
+    }
+    
+    // Objects are registered once with each context that holds them, including import, outbound, and prefetch contexts, and are only forgotten once the last of those contexts unregisters them
+    NSMutableArray *mutableUnregisteredObjectIDs = [NSMutableArray arrayWithCapacity:[objectIDs count]];
+    dispatch_barrier_sync(_registeredObjectIDsQueue, ^{
+        [objectIDs enumerateObjectsUsingBlock:^(NSManagedObjectID *objectID, NSUInteger idx, __unused BOOL *stop) {
+            [_registeredObjectIDs removeObject:objectID];
+            if ([_registeredObjectIDs countForObject:objectID] > 0) {
+                return;
+            }
+            
+            // Another object ID may have been registered for the same resource since, such as one of a subentity
+            NSMutableDictionary *mutableObjectIDsByResourceIdentifier = [_registeredObjectIDsByResourceIdentifierByEntityName objectForKey:AFRootEntityName([objectID entity])];
+            NSString *resourceIdentifier = [mutableResourceIdentifiers objectAtIndex:idx];
+            if ([[mutableObjectIDsByResourceIdentifier objectForKey:resourceIdentifier] isEqual:objectID]) {
+                [mutableObjectIDsByResourceIdentifier removeObjectForKey:resourceIdentifier];
+            }
+            [mutableUnregisteredObjectIDs addObject:objectID];
+        }];
+    });
+    
+    // Faults of objects that no context holds any longer are no longer waited on
+    [self cancelPendingRemoteFaultsForObjectsWithIDs:mutableUnregisteredObjectIDs];
+}
+
+@end
+
+#pragma mark -
+
+@interface AFEntityMapping ()
+@property (readwrite, nonatomic, strong) NSEntityDescription *entity;
+@property (readwrite, nonatomic, strong) NSArray *attributeNames;
+@property (readwrite, nonatomic, strong) NSSet *propertyNames;
+@property (readwrite, nonatomic, strong) NSDictionary *attributesByName;
+@property (readwrite, nonatomic, strong) NSDictionary *relationshipsByName;
+@property (readwrite, nonatomic, strong) NSDictionary *destinationEntitiesByRelationshipName;
+@property (readwrite, nonatomic, strong) NSSet *toManyRelationshipNames;
+@property (readwrite, nonatomic, strong) NSSet *orderedRelationshipNames;
+@property (readwrite, nonatomic, strong) NSDictionary *valueTransformersByAttributeName;
+@end
+
+@implementation AFEntityMapping
+@synthesize entity = _entity;
+@synthesize attributeNames = _attributeNames;
+@synthesize propertyNames = _propertyNames;
+@synthesize attributesByName = _attributesByName;
+@synthesize relationshipsByName = _relationshipsByName;
+@synthesize destinationEntitiesByRelationshipName = _destinationEntitiesByRelationshipName;
+@synthesize toManyRelationshipNames = _toManyRelationshipNames;
+@synthesize orderedRelationshipNames = _orderedRelationshipNames;
+@synthesize valueTransformersByAttributeName = _valueTransformersByAttributeName;
+
+- (id)initWithEntity:(NSEntityDescription *)entity {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+    
+    self.entity = entity;
+    self.attributesByName = [entity attributesByName];
+    self.attributeNames = [self.attributesByName allKeys];
+    self.propertyNames = [NSSet setWithArray:[[entity propertiesByName] allKeys]];
+    self.relationshipsByName = [entity relationshipsByName];
+    
+    NSMutableDictionary *mutableDestinationEntitiesByRelationshipName = [NSMutableDictionary dictionaryWithCapacity:[self.relationshipsByName count]];
+    NSMutableSet *mutableToManyRelationshipNames = [NSMutableSet set];
+    NSMutableSet *mutableOrderedRelationshipNames = [NSMutableSet set];
+    [self.relationshipsByName enumerateKeysAndObjectsUsingBlock:^(id name, id relationship, __unused BOOL *stop) {
+        [mutableDestinationEntitiesByRelationshipName setValue:[relationship destinationEntity] forKey:name];
+        if ([relationship isToMany]) {
+            [mutableToManyRelationshipNames addObject:name];
+            if ([relationship isOrdered]) {
+                [mutableOrderedRelationshipNames addObject:name];
+            }
+        }
+    }];
+    self.destinationEntitiesByRelationshipName = mutableDestinationEntitiesByRelationshipName;
+    self.toManyRelationshipNames = mutableToManyRelationshipNames;
+    self.orderedRelationshipNames = mutableOrderedRelationshipNames;
+    
+    NSMutableDictionary *mutableValueTransformersByAttributeName = [NSMutableDictionary dictionary];
+    [self.attributesByName enumerateKeysAndObjectsUsingBlock:^(id name, id attribute, __unused BOOL *stop) {
+        if ([attribute attributeType] == NSTransformableAttributeType && [attribute valueTransformerName]) {
+            [mutableValueTransformersByAttributeName setValue:[NSValueTransformer valueTransformerForName:[attribute valueTransformerName]] forKey:name];
+        }
+    }];
+    self.valueTransformersByAttributeName = mutableValueTransformersByAttributeName;
+    
+    return self;
 }
 
 @end
@@ -26,9 +26,16 @@
 
 /**
  `AFRESTClient` is a subclass of `AFHTTPClient` that implements the `AFIncrementalStoreHTTPClient` protocol in a way that follows the conventions of a RESTful web service.
+ 
+ @discussion Attribute faults are fetched with one request for each object, unless a subclass for a web service that can return several resources by identifier implements `-requestWithMethod:pathForObjectsWithIDs:withContext:`. Likewise, local changes are not sent to the server by default. To send them, a subclass implements `-requestForInsertedObject:`, `-requestForUpdatedObject:`, and `-requestForDeletedObject:`, for example by returning `[self requestWithMethod:@"POST" path:[self pathForEntity:insertedObject.entity] parameters:[self representationOfAttributes:attributes ofManagedObject:insertedObject]]` for an inserted object. Results of fetch requests are not paginated either, since `fetchBatchSize` and `fetchLimit` may not correspond to any page size of the web service. A subclass for a paginated web service implements `-requestForFetchRequest:withPageCursor:withContext:` and `-pageCursorFollowingPageCursor:ofFetchRequest:withRepresentations:fromResponse:`, for example with an `offset` parameter as the page cursor, and a `limit` parameter.
  */
 @interface AFRESTClient : AFHTTPClient <AFIncrementalStoreHTTPClient>
 
+/**
+ The date formats used to parse string values of date attributes in representations, in the order they are tried. Dates are parsed in the `en_US_POSIX` locale, and in UTC unless the format specifies a time zone. By default, ISO 8601 timestamps with and without fractional seconds, and `yyyy-MM-dd` dates, are recognized.
+ */
+@property (nonatomic, copy) NSArray *dateFormats;
+
 /**
  Returns the request path for a collection of resources of the specified entity. By default, this returns an imprecise pluralization of the entity name.
  
@@ -64,4 +71,74 @@
 - (NSString *)pathForRelationship:(NSRelationshipDescription *)relationship
                         forObject:(NSManagedObject *)object;
 
+/**
+ Registers the attributes corresponding to key paths of the representations of a particular entity. Values at registered key paths are mapped to their attribute by `-attributesForRepresentation:ofEntity:fromResponse:`, in addition to the values of keys that share the name of an attribute, which registered key paths take precedence over. Names registered for an entity also apply to its subentities.
+ 
+ @discussion For example, registering `@{ @"id" : @"userID", @"screen_name" : @"username", @"status.created_at" : @"lastTweetedAt" }` for the `User` entity maps those fields without overriding `-attributesForRepresentation:ofEntity:fromResponse:`. Registered key paths are compiled once for each entity, and applied without intermediate copies of the representation. This method is typically called from `-initWithBaseURL:` in a subclass.
+ 
+ @param attributeNamesByKeyPath An `NSDictionary` of attribute names, keyed by representation key path.
+ @param entityName The name of the entity of the attributes.
+ */
+- (void)registerAttributeNames:(NSDictionary *)attributeNamesByKeyPath
+                 forEntityName:(NSString *)entityName;
+
+/**
+ Returns a representation value converted to the type of the specified attribute. By default, strings are converted to numbers for numeric and boolean attributes, numbers and URLs to strings for string attributes, strings to URLs for transformable attributes of class `NSURL`, and UNIX timestamps as well as strings in one of the `dateFormats` to dates for date attributes. Other values are returned unchanged.
+ 
+ @param attribute The attribute for the value.
+ @param value The value found in the representation.
+ 
+ @return The value to set for the attribute, or `nil` if the value could not be converted.
+ */
+- (id)valueForAttribute:(NSAttributeDescription *)attribute
+fromRepresentationValue:(id)value;
+
+/**
+ Returns the representation of the specified attributes of a managed object, as sent in the body of the requests that create and update its resource. Attributes are keyed by the top-level key registered for them with `-registerAttributeNames:forEntityName:`, or by their own name otherwise. Dates are formatted with the first of the `dateFormats`, URLs are converted to strings, and values that are not strings, numbers, or `NSNull` are left out.
+ 
+ @param attributes An `NSDictionary` of attribute values, keyed by attribute name.
+ @param managedObject The managed object of the attributes.
+ 
+ @return An `NSDictionary` representation of the attributes.
+ */
+- (NSDictionary *)representationOfAttributes:(NSDictionary *)attributes
+                             ofManagedObject:(NSManagedObject *)managedObject;
+
+/**
+ Registers the names of the query parameters corresponding to keys of a particular entity. Only predicates and sort descriptors on registered keys are translated into query parameters by `-queryParametersForPredicate:ofEntity:` and `-queryParametersForSortDescriptors:ofEntity:`. Names registered for an entity also apply to its subentities.
+ 
+ @discussion For example, registering `@{ @"artist" : @"artist_id", @"createdAt" : @"created_at" }` for the `Song` entity translates a fetch request for songs with the predicate `artist == %@` and a descending sort descriptor on `createdAt` into `GET /songs?artist_id=3&sort=-created_at`. This method is typically called from `-initWithBaseURL:` in a subclass.
+ 
+ @param parameterNamesByKey An `NSDictionary` of query parameter names, keyed by attribute or relationship name.
+ @param entityName The name of the entity of the keys.
+ */
+- (void)registerQueryParameterNames:(NSDictionary *)parameterNamesByKey
+                      forEntityName:(NSString *)entityName;
+
+/**
+ Returns the query parameters filtering the resources of an entity with the same constraints as the specified predicate. By default, `==` comparisons translate to `name=value`, `IN` comparisons to `name=value1,value2`, and `<`, `<=`, `>` and `>=` comparisons to `name_lt`, `name_lte`, `name_gt` and `name_gte` parameters, for keys registered with `-registerQueryParameterNames:forEntityName:`. Managed objects are represented by their resource identifier, and dates by their UNIX timestamp.
+ 
+ @discussion Only the constraints that can be expressed are translated, which is each translatable subpredicate of an `AND` predicate, so the server returns a superset of the matching resources. Fetched results are always filtered locally with the complete predicate.
+ 
+ @param predicate The predicate to translate.
+ @param entity The entity of the fetch request.
+ 
+ @return An `NSDictionary` of query parameters, which is empty if no constraint of the predicate can be translated.
+ */
+- (NSDictionary *)queryParametersForPredicate:(NSPredicate *)predicate
+                                     ofEntity:(NSEntityDescription *)entity;
+
+/**
+ Returns the query parameters sorting the resources of an entity in the same order as the specified sort descriptors. By default, this returns a `sort` parameter with a comma-separated list of query parameter names registered with `-registerQueryParameterNames:forEntityName:`, each prefixed with `-` if descending.
+ 
+ @discussion Translation stops at the first sort descriptor whose key is not registered, since sorting by some of the keys only would not order pages of results in the same way as the fetch request.
+ 
+ @param sortDescriptors The sort descriptors to translate.
+ @param entity The entity of the fetch request.
+ 
+ @return An `NSDictionary` of query parameters, or `nil` if the first sort descriptor cannot be translated.
+ */
+- (NSDictionary *)queryParametersForSortDescriptors:(NSArray *)sortDescriptors
+                                           ofEntity:(NSEntityDescription *)entity;
+
 @end
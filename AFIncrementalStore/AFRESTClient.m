@@ -30,7 +30,104 @@ static NSString * AFPluralizedString(NSString *string) {
     }
 }
 
-@implementation AFRESTClient
+static NSString * AFQueryParameterValueFromObject(id value) {
+    if ([value isKindOfClass:[NSManagedObject class]]) {
+        value = [(NSManagedObject *)value objectID];
+    }
+    
+    if ([value isKindOfClass:[NSManagedObjectID class]]) {
+        NSManagedObjectID *objectID = (NSManagedObjectID *)value;
+        if (![objectID.persistentStore isKindOfClass:[NSIncrementalStore class]] || [objectID isTemporaryID]) {
+            return nil;
+        }
+        
+        return [[(NSIncrementalStore *)objectID.persistentStore referenceObjectForObjectID:objectID] lastPathComponent];
+    } else if ([value isKindOfClass:[NSDate class]]) {
+        return [NSString stringWithFormat:@"%lld", (long long)[(NSDate *)value timeIntervalSince1970]];
+    } else if ([value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]]) {
+        return [value description];
+    }
+    
+    return nil;
+}
+
+static NSDateFormatter * AFDateFormatterWithFormat(NSString *dateFormat) {
+    // Date formatters are not thread-safe, so each thread keeps its own
+    NSMutableDictionary *mutableDateFormattersByFormat = [[[NSThread currentThread] threadDictionary] objectForKey:@"AFRESTClientDateFormatters"];
+    if (!mutableDateFormattersByFormat) {
+        mutableDateFormattersByFormat = [NSMutableDictionary dictionary];
+        [[[NSThread currentThread] threadDictionary] setObject:mutableDateFormattersByFormat forKey:@"AFRESTClientDateFormatters"];
+    }
+    
+    NSDateFormatter *dateFormatter = [mutableDateFormattersByFormat objectForKey:dateFormat];
+    if (!dateFormatter) {
+        dateFormatter = [[NSDateFormatter alloc] init];
+        dateFormatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+        dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+        dateFormatter.dateFormat = dateFormat;
+        [mutableDateFormattersByFormat setObject:dateFormatter forKey:dateFormat];
+    }
+    
+    return dateFormatter;
+}
+
+static NSDate * AFDateFromString(NSString *string, NSArray *dateFormats) {
+    for (NSString *dateFormat in dateFormats) {
+        NSDate *date = [AFDateFormatterWithFormat(dateFormat) dateFromString:string];
+        if (date) {
+            return date;
+        }
+    }
+    
+    return nil;
+}
+
+@interface AFAttributeKeyPathMapping : NSObject
+@property (nonatomic, copy) NSString *keyPath;
+@property (nonatomic, assign, getter = isNested) BOOL nested;
+@property (nonatomic, strong) NSAttributeDescription *attribute;
+@end
+
+@implementation AFAttributeKeyPathMapping
+@synthesize keyPath = _keyPath;
+@synthesize nested = _nested;
+@synthesize attribute = _attribute;
+@end
+
+#pragma mark -
+
+@implementation AFRESTClient {
+@private
+    NSMutableDictionary *_queryParameterNamesByKeyByEntityName;
+    NSMutableDictionary *_attributeNamesByKeyPathByEntityName;
+    NSMutableDictionary *_attributeKeyPathMappingsByEntityName;
+    dispatch_queue_t _mappingsQueue;
+}
+@synthesize dateFormats = _dateFormats;
+
+- (id)initWithBaseURL:(NSURL *)url {
+    self = [super initWithBaseURL:url];
+    if (!self) {
+        return nil;
+    }
+    
+    _queryParameterNamesByKeyByEntityName = [[NSMutableDictionary alloc] init];
+    _attributeNamesByKeyPathByEntityName = [[NSMutableDictionary alloc] init];
+    _attributeKeyPathMappingsByEntityName = [[NSMutableDictionary alloc] init];
+    self.dateFormats = [NSArray arrayWithObjects:@"yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ", @"yyyy-MM-dd'T'HH:mm:ssZZZZZ", @"yyyy-MM-dd'T'HH:mm:ss'Z'", @"yyyy-MM-dd", nil];
+    _mappingsQueue = dispatch_queue_create("com.alamofire.rest-client.mappings", DISPATCH_QUEUE_SERIAL);
+    
+    return self;
+}
+
+- (void)dealloc {
+    if (_mappingsQueue) {
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(_mappingsQueue);
+#endif
+        _mappingsQueue = NULL;
+    }
+}
 
 - (NSString *)pathForEntity:(NSEntityDescription *)entity {
     return AFPluralizedString(entity.name);
@@ -47,6 +144,299 @@ static NSString * AFPluralizedString(NSString *string) {
     return [[self pathForObject:object] stringByAppendingPathComponent:relationship.name];
 }
 
+- (void)registerQueryParameterNames:(NSDictionary *)parameterNamesByKey
+                      forEntityName:(NSString *)entityName
+{
+    dispatch_sync(_mappingsQueue, ^{
+        NSMutableDictionary *mutableParameterNamesByKey = [_queryParameterNamesByKeyByEntityName objectForKey:entityName];
+        if (!mutableParameterNamesByKey) {
+            mutableParameterNamesByKey = [NSMutableDictionary dictionaryWithCapacity:[parameterNamesByKey count]];
+            [_queryParameterNamesByKeyByEntityName setObject:mutableParameterNamesByKey forKey:entityName];
+        }
+        [mutableParameterNamesByKey addEntriesFromDictionary:parameterNamesByKey];
+    });
+}
+
+- (void)registerAttributeNames:(NSDictionary *)attributeNamesByKeyPath
+                 forEntityName:(NSString *)entityName
+{
+    dispatch_sync(_mappingsQueue, ^{
+        NSMutableDictionary *mutableAttributeNamesByKeyPath = [_attributeNamesByKeyPathByEntityName objectForKey:entityName];
+        if (!mutableAttributeNamesByKeyPath) {
+            mutableAttributeNamesByKeyPath = [NSMutableDictionary dictionaryWithCapacity:[attributeNamesByKeyPath count]];
+            [_attributeNamesByKeyPathByEntityName setObject:mutableAttributeNamesByKeyPath forKey:entityName];
+        }
+        [mutableAttributeNamesByKeyPath addEntriesFromDictionary:attributeNamesByKeyPath];
+        
+        // Compiled mappings of subentities include the names registered for this entity, so all of them are compiled again
+        [_attributeKeyPathMappingsByEntityName removeAllObjects];
+    });
+}
+
+- (NSArray *)attributeKeyPathMappingsForEntity:(NSEntityDescription *)entity {
+    __block NSArray *attributeKeyPathMappings = nil;
+    dispatch_sync(_mappingsQueue, ^{
+        attributeKeyPathMappings = [_attributeKeyPathMappingsByEntityName objectForKey:entity.name];
+        if (attributeKeyPathMappings) {
+            return;
+        }
+        
+        NSMutableDictionary *mutableAttributeNamesByKeyPath = [NSMutableDictionary dictionary];
+        for (NSEntityDescription *candidateEntity = entity; candidateEntity; candidateEntity = [candidateEntity superentity]) {
+            [[_attributeNamesByKeyPathByEntityName objectForKey:candidateEntity.name] enumerateKeysAndObjectsUsingBlock:^(id keyPath, id attributeName, __unused BOOL *stop) {
+                if (![mutableAttributeNamesByKeyPath objectForKey:keyPath]) {
+                    [mutableAttributeNamesByKeyPath setObject:attributeName forKey:keyPath];
+                }
+            }];
+        }
+        
+        NSDictionary *attributesByName = [entity attributesByName];
+        NSMutableArray *mutableAttributeKeyPathMappings = [NSMutableArray arrayWithCapacity:[mutableAttributeNamesByKeyPath count]];
+        [mutableAttributeNamesByKeyPath enumerateKeysAndObjectsUsingBlock:^(id keyPath, id attributeName, __unused BOOL *stop) {
+            NSAttributeDescription *attribute = [attributesByName objectForKey:attributeName];
+            if (!attribute) {
+                return;
+            }
+            
+            AFAttributeKeyPathMapping *attributeKeyPathMapping = [[AFAttributeKeyPathMapping alloc] init];
+            attributeKeyPathMapping.keyPath = keyPath;
+            attributeKeyPathMapping.nested = [keyPath rangeOfString:@"."].location != NSNotFound;
+            attributeKeyPathMapping.attribute = attribute;
+            [mutableAttributeKeyPathMappings addObject:attributeKeyPathMapping];
+        }];
+        
+        attributeKeyPathMappings = mutableAttributeKeyPathMappings;
+        [_attributeKeyPathMappingsByEntityName setObject:attributeKeyPathMappings forKey:entity.name];
+    });
+    
+    return attributeKeyPathMappings;
+}
+
+- (id)valueForAttribute:(NSAttributeDescription *)attribute
+fromRepresentationValue:(id)value
+{
+    if (!value || [value isEqual:[NSNull null]]) {
+        return value;
+    }
+    
+    switch ([attribute attributeType]) {
+        case NSInteger16AttributeType:
+        case NSInteger32AttributeType:
+        case NSInteger64AttributeType:
+            if ([value isKindOfClass:[NSString class]]) {
+                return [NSNumber numberWithLongLong:[value longLongValue]];
+            }
+            break;
+        case NSDecimalAttributeType:
+            if ([value isKindOfClass:[NSString class]]) {
+                return [NSDecimalNumber decimalNumberWithString:value];
+            } else if ([value isKindOfClass:[NSNumber class]] && ![value isKindOfClass:[NSDecimalNumber class]]) {
+                return [NSDecimalNumber decimalNumberWithDecimal:[value decimalValue]];
+            }
+            break;
+        case NSDoubleAttributeType:
+        case NSFloatAttributeType:
+            if ([value isKindOfClass:[NSString class]]) {
+                return [NSNumber numberWithDouble:[value doubleValue]];
+            }
+            break;
+        case NSBooleanAttributeType:
+            if ([value isKindOfClass:[NSString class]]) {
+                return [NSNumber numberWithBool:[value boolValue]];
+            }
+            break;
+        case NSStringAttributeType:
+            if ([value isKindOfClass:[NSNumber class]]) {
+                return [value stringValue];
+            } else if ([value isKindOfClass:[NSURL class]]) {
+                return [value absoluteString];
+            }
+            break;
+        case NSDateAttributeType:
+            if ([value isKindOfClass:[NSNumber class]]) {
+                return [NSDate dateWithTimeIntervalSince1970:[value doubleValue]];
+            } else if ([value isKindOfClass:[NSString class]]) {
+                return AFDateFromString(value, self.dateFormats);
+            }
+            break;
+        case NSTransformableAttributeType:
+            if ([value isKindOfClass:[NSString class]] && [[attribute attributeValueClassName] isEqualToString:@"NSURL"]) {
+                return [NSURL URLWithString:value];
+            }
+            break;
+        default:
+            break;
+    }
+    
+    return value;
+}
+
+- (NSDictionary *)representationOfAttributes:(NSDictionary *)attributes
+                             ofManagedObject:(NSManagedObject *)managedObject
+{
+    // Attributes are sent under the top-level key registered for them, if any, and otherwise under their own name
+    NSMutableDictionary *mutableKeysByAttributeName = [NSMutableDictionary dictionary];
+    for (AFAttributeKeyPathMapping *attributeKeyPathMapping in [self attributeKeyPathMappingsForEntity:managedObject.entity]) {
+        if (![attributeKeyPathMapping isNested]) {
+            [mutableKeysByAttributeName setObject:attributeKeyPathMapping.keyPath forKey:[attributeKeyPathMapping.attribute name]];
+        }
+    }
+    
+    NSMutableDictionary *mutableRepresentation = [NSMutableDictionary dictionaryWithCapacity:[attributes count]];
+    [attributes enumerateKeysAndObjectsUsingBlock:^(id attributeName, id value, __unused BOOL *stop) {
+        if ([value isKindOfClass:[NSDate class]]) {
+            value = [self.dateFormats count] > 0 ? [AFDateFormatterWithFormat([self.dateFormats objectAtIndex:0]) stringFromDate:value] : [NSNumber numberWithDouble:[value timeIntervalSince1970]];
+        } else if ([value isKindOfClass:[NSURL class]]) {
+            value = [value absoluteString];
+        } else if (![value isKindOfClass:[NSString class]] && ![value isKindOfClass:[NSNumber class]] && ![value isEqual:[NSNull null]]) {
+            return;
+        }
+        
+        [mutableRepresentation setObject:value forKey:[mutableKeysByAttributeName objectForKey:attributeName] ?: attributeName];
+    }];
+    
+    return mutableRepresentation;
+}
+
+- (NSString *)queryParameterNameForKey:(NSString *)key
+                              ofEntity:(NSEntityDescription *)entity
+{
+    __block NSString *parameterName = nil;
+    dispatch_sync(_mappingsQueue, ^{
+        // Names registered for an entity also apply to its subentities
+        for (NSEntityDescription *candidateEntity = entity; candidateEntity && !parameterName; candidateEntity = [candidateEntity superentity]) {
+            parameterName = [[_queryParameterNamesByKeyByEntityName objectForKey:candidateEntity.name] objectForKey:key];
+        }
+    });
+    
+    return parameterName;
+}
+
+- (NSDictionary *)queryParametersForPredicate:(NSPredicate *)predicate
+                                     ofEntity:(NSEntityDescription *)entity
+{
+    NSMutableDictionary *mutableParameters = [NSMutableDictionary dictionary];
+    
+    // Only the conjuncts of an `AND` can be translated independently, since the server then returns a superset of the matching resources, which the backing store filters with the complete predicate
+    if ([predicate isKindOfClass:[NSCompoundPredicate class]]) {
+        NSCompoundPredicate *compoundPredicate = (NSCompoundPredicate *)predicate;
+        if ([compoundPredicate compoundPredicateType] == NSAndPredicateType) {
+            for (NSPredicate *subpredicate in [compoundPredicate subpredicates]) {
+                NSDictionary *parameters = [self queryParametersForPredicate:subpredicate ofEntity:entity];
+                for (NSString *parameterName in parameters) {
+                    if (![mutableParameters objectForKey:parameterName]) {
+                        [mutableParameters setObject:[parameters objectForKey:parameterName] forKey:parameterName];
+                    }
+                }
+            }
+        }
+    } else if ([predicate isKindOfClass:[NSComparisonPredicate class]]) {
+        NSComparisonPredicate *comparisonPredicate = (NSComparisonPredicate *)predicate;
+        if ([comparisonPredicate comparisonPredicateModifier] != NSDirectPredicateModifier || ([comparisonPredicate options] & (NSCaseInsensitivePredicateOption | NSDiacriticInsensitivePredicateOption))) {
+            return mutableParameters;
+        }
+        
+        NSExpression *leftExpression = [comparisonPredicate leftExpression];
+        NSExpression *rightExpression = [comparisonPredicate rightExpression];
+        NSPredicateOperatorType operatorType = [comparisonPredicate predicateOperatorType];
+        
+        // `%@ < key` is handled as `key > %@`
+        if ([leftExpression expressionType] == NSConstantValueExpressionType && [rightExpression expressionType] == NSKeyPathExpressionType) {
+            NSExpression *expression = leftExpression;
+            leftExpression = rightExpression;
+            rightExpression = expression;
+            
+            switch (operatorType) {
+                case NSLessThanPredicateOperatorType:
+                    operatorType = NSGreaterThanPredicateOperatorType;
+                    break;
+                case NSLessThanOrEqualToPredicateOperatorType:
+                    operatorType = NSGreaterThanOrEqualToPredicateOperatorType;
+                    break;
+                case NSGreaterThanPredicateOperatorType:
+                    operatorType = NSLessThanPredicateOperatorType;
+                    break;
+                case NSGreaterThanOrEqualToPredicateOperatorType:
+                    operatorType = NSLessThanOrEqualToPredicateOperatorType;
+                    break;
+                case NSEqualToPredicateOperatorType:
+                    break;
+                default:
+                    return mutableParameters;
+            }
+        }
+        
+        if ([leftExpression expressionType] != NSKeyPathExpressionType || [rightExpression expressionType] != NSConstantValueExpressionType) {
+            return mutableParameters;
+        }
+        
+        NSString *parameterName = [self queryParameterNameForKey:[leftExpression keyPath] ofEntity:entity];
+        if (!parameterName) {
+            return mutableParameters;
+        }
+        
+        id constantValue = [rightExpression constantValue];
+        switch (operatorType) {
+            case NSEqualToPredicateOperatorType:
+                [mutableParameters setValue:AFQueryParameterValueFromObject(constantValue) forKey:parameterName];
+                break;
+            case NSInPredicateOperatorType: {
+                if (![constantValue conformsToProtocol:@protocol(NSFastEnumeration)] || [constantValue isKindOfClass:[NSString class]]) {
+                    break;
+                }
+                
+                NSMutableArray *mutableValues = [NSMutableArray array];
+                for (id value in constantValue) {
+                    NSString *parameterValue = AFQueryParameterValueFromObject(value);
+                    if (!parameterValue) {
+                        return mutableParameters;
+                    }
+                    [mutableValues addObject:parameterValue];
+                }
+                [mutableParameters setObject:[mutableValues componentsJoinedByString:@","] forKey:parameterName];
+                break;
+            }
+            case NSLessThanPredicateOperatorType:
+                [mutableParameters setValue:AFQueryParameterValueFromObject(constantValue) forKey:[parameterName stringByAppendingString:@"_lt"]];
+                break;
+            case NSLessThanOrEqualToPredicateOperatorType:
+                [mutableParameters setValue:AFQueryParameterValueFromObject(constantValue) forKey:[parameterName stringByAppendingString:@"_lte"]];
+                break;
+            case NSGreaterThanPredicateOperatorType:
+                [mutableParameters setValue:AFQueryParameterValueFromObject(constantValue) forKey:[parameterName stringByAppendingString:@"_gt"]];
+                break;
+            case NSGreaterThanOrEqualToPredicateOperatorType:
+                [mutableParameters setValue:AFQueryParameterValueFromObject(constantValue) forKey:[parameterName stringByAppendingString:@"_gte"]];
+                break;
+            default:
+                break;
+        }
+    }
+    
+    return mutableParameters;
+}
+
+- (NSDictionary *)queryParametersForSortDescriptors:(NSArray *)sortDescriptors
+                                           ofEntity:(NSEntityDescription *)entity
+{
+    NSMutableArray *mutableSortFields = [NSMutableArray arrayWithCapacity:[sortDescriptors count]];
+    for (NSSortDescriptor *sortDescriptor in sortDescriptors) {
+        // Sorting by the leading keys alone would order pages differently than the backing store, so translation stops at the first key without a query parameter name
+        NSString *parameterName = [self queryParameterNameForKey:[sortDescriptor key] ofEntity:entity];
+        if (!parameterName) {
+            break;
+        }
+        
+        [mutableSortFields addObject:[sortDescriptor ascending] ? parameterName : [@"-" stringByAppendingString:parameterName]];
+    }
+    
+    if ([mutableSortFields count] == 0) {
+        return nil;
+    }
+    
+    return [NSDictionary dictionaryWithObject:[mutableSortFields componentsJoinedByString:@","] forKey:@"sort"];
+}
+
 #pragma mark - AFIncrementalStoreHTTPClient
 
 - (id)representationOrArrayOfRepresentationsFromResponseObject:(id)responseObject {
@@ -118,17 +508,22 @@ static NSString * AFPluralizedString(NSString *string) {
                                      ofEntity:(NSEntityDescription *)entity
                                  fromResponse:(NSHTTPURLResponse *)response
 {
-    NSMutableDictionary *mutableAttributes = [representation mutableCopy];
-    @autoreleasepool {
-        NSMutableSet *mutableKeys = [NSMutableSet setWithArray:[representation allKeys]];
-        [mutableKeys minusSet:[NSSet setWithArray:[[entity propertiesByName] allKeys]]];
-        [mutableAttributes removeObjectsForKeys:[mutableKeys allObjects]];
-    }
-    
-    NSSet *keysWithNestedValues = [mutableAttributes keysOfEntriesPassingTest:^BOOL(id key, id obj, BOOL *stop) {
-        return [obj isKindOfClass:[NSArray class]] || [obj isKindOfClass:[NSDictionary class]];
+    // Keys named after attributes of the entity are mapped in a single pass over the representation, followed by a pass over the registered key paths, which take precedence
+    NSDictionary *attributesByName = [entity attributesByName];
+    NSMutableDictionary *mutableAttributes = [NSMutableDictionary dictionaryWithCapacity:[representation count]];
+    [representation enumerateKeysAndObjectsUsingBlock:^(id key, id value, __unused BOOL *stop) {
+        NSAttributeDescription *attribute = [attributesByName objectForKey:key];
+        if (attribute && ![value isKindOfClass:[NSArray class]] && ![value isKindOfClass:[NSDictionary class]]) {
+            [mutableAttributes setValue:[self valueForAttribute:attribute fromRepresentationValue:value] forKey:key];
+        }
     }];
-    [mutableAttributes removeObjectsForKeys:[keysWithNestedValues allObjects]];
+    
+    for (AFAttributeKeyPathMapping *attributeKeyPathMapping in [self attributeKeyPathMappingsForEntity:entity]) {
+        id value = [attributeKeyPathMapping isNested] ? [representation valueForKeyPath:attributeKeyPathMapping.keyPath] : [representation objectForKey:attributeKeyPathMapping.keyPath];
+        if (value) {
+            [mutableAttributes setValue:[self valueForAttribute:attributeKeyPathMapping.attribute fromRepresentationValue:value] forKey:[attributeKeyPathMapping.attribute name]];
+        }
+    }
     
     return mutableAttributes;
 }
@@ -136,10 +531,11 @@ static NSString * AFPluralizedString(NSString *string) {
 - (NSURLRequest *)requestForFetchRequest:(NSFetchRequest *)fetchRequest 
                              withContext:(NSManagedObjectContext *)context
 {
-    NSMutableURLRequest *mutableRequest =  [self requestWithMethod:@"GET" path:[self pathForEntity:fetchRequest.entity] parameters:nil];
-    mutableRequest.cachePolicy = NSURLRequestReturnCacheDataElseLoad;
+    NSMutableDictionary *mutableParameters = [NSMutableDictionary dictionary];
+    [mutableParameters addEntriesFromDictionary:[self queryParametersForPredicate:fetchRequest.predicate ofEntity:fetchRequest.entity]];
+    [mutableParameters addEntriesFromDictionary:[self queryParametersForSortDescriptors:fetchRequest.sortDescriptors ofEntity:fetchRequest.entity]];
     
-    return mutableRequest;
+    return [self requestWithMethod:@"GET" path:[self pathForEntity:fetchRequest.entity] parameters:([mutableParameters count] > 0 ? mutableParameters : nil)];
 }
 
 - (NSURLRequest *)requestWithMethod:(NSString *)method
@@ -166,11 +562,4 @@ static NSString * AFPluralizedString(NSString *string) {
     return [relationship isToMany] || ![relationship inverseRelationship];
 }
 
-#pragma mark - AFHTTPClient
-
-- (void)enqueueHTTPRequestOperation:(AFHTTPRequestOperation *)operation {
-    [self cancelAllHTTPOperationsWithMethod:operation.request.HTTPMethod path:operation.request.URL.path];
-    [super enqueueHTTPRequestOperation:operation];
-}
-
 @end
@@ -0,0 +1,57 @@
+// AFBenchmarkFixtures.h
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ `AFBenchmarkFixtures` generates the JSON served to the benchmarks, in the conventions followed by `AFRESTClient`. Artists are identified from `1`, and the songs of an artist are identified from `1000` times its identifier, so that the same fixtures always describe the same resources.
+ */
+@interface AFBenchmarkFixtures : NSObject
+
+/**
+ Returns a JSON array of artists, each with a `name`, and optionally an `artistDescription` and embedded `songs`.
+ 
+ @param range The range of the identifiers of the artists.
+ @param numberOfSongs The number of songs embedded in each artist, or `0` to embed none.
+ @param includesDescriptions Whether each artist has an `artistDescription`.
+ */
++ (NSData *)JSONDataForArtistsWithIdentifiersInRange:(NSRange)range
+                                       numberOfSongs:(NSUInteger)numberOfSongs
+                                includesDescriptions:(BOOL)includesDescriptions;
+
+/**
+ Returns a JSON array of the artists with the specified identifiers, each with a `name` and an `artistDescription`.
+ 
+ @param identifiers The identifiers of the artists, as strings or numbers.
+ */
++ (NSData *)JSONDataForArtistsWithIdentifiers:(NSArray *)identifiers;
+
+/**
+ Returns a JSON array of the songs of an artist, each with a `title`.
+ 
+ @param artistIdentifier The identifier of the artist.
+ @param numberOfSongs The number of songs.
+ */
++ (NSData *)JSONDataForSongsOfArtistWithIdentifier:(NSUInteger)artistIdentifier
+                                     numberOfSongs:(NSUInteger)numberOfSongs;
+
+@end
@@ -0,0 +1,80 @@
+// AFBenchmarkFixtures.m
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "AFBenchmarkFixtures.h"
+
+static NSArray * AFBenchmarkSongRepresentations(NSUInteger artistIdentifier, NSUInteger numberOfSongs) {
+    NSMutableArray *mutableRepresentations = [NSMutableArray arrayWithCapacity:numberOfSongs];
+    for (NSUInteger idx = 0; idx < numberOfSongs; idx++) {
+        NSUInteger identifier = artistIdentifier * 1000 + idx;
+        [mutableRepresentations addObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithUnsignedInteger:identifier], @"id", [NSString stringWithFormat:@"Song %lu", (unsigned long)identifier], @"title", nil]];
+    }
+    
+    return mutableRepresentations;
+}
+
+static NSDictionary * AFBenchmarkArtistRepresentation(NSUInteger identifier, NSUInteger numberOfSongs, BOOL includesDescription) {
+    NSMutableDictionary *mutableRepresentation = [NSMutableDictionary dictionaryWithCapacity:4];
+    [mutableRepresentation setObject:[NSNumber numberWithUnsignedInteger:identifier] forKey:@"id"];
+    [mutableRepresentation setObject:[NSString stringWithFormat:@"Artist %lu", (unsigned long)identifier] forKey:@"name"];
+    if (includesDescription) {
+        [mutableRepresentation setObject:[NSString stringWithFormat:@"The description of artist %lu, which is long enough to be representative of the text attributes of a typical resource.", (unsigned long)identifier] forKey:@"artistDescription"];
+    }
+    if (numberOfSongs > 0) {
+        [mutableRepresentation setObject:AFBenchmarkSongRepresentations(identifier, numberOfSongs) forKey:@"songs"];
+    }
+    
+    return mutableRepresentation;
+}
+
+@implementation AFBenchmarkFixtures
+
++ (NSData *)JSONDataForArtistsWithIdentifiersInRange:(NSRange)range
+                                       numberOfSongs:(NSUInteger)numberOfSongs
+                                includesDescriptions:(BOOL)includesDescriptions
+{
+    NSMutableArray *mutableRepresentations = [NSMutableArray arrayWithCapacity:range.length];
+    for (NSUInteger identifier = range.location; identifier < NSMaxRange(range); identifier++) {
+        @autoreleasepool {
+            [mutableRepresentations addObject:AFBenchmarkArtistRepresentation(identifier, numberOfSongs, includesDescriptions)];
+        }
+    }
+    
+    return [NSJSONSerialization dataWithJSONObject:mutableRepresentations options:0 error:nil];
+}
+
++ (NSData *)JSONDataForArtistsWithIdentifiers:(NSArray *)identifiers {
+    NSMutableArray *mutableRepresentations = [NSMutableArray arrayWithCapacity:[identifiers count]];
+    for (id identifier in identifiers) {
+        [mutableRepresentations addObject:AFBenchmarkArtistRepresentation([identifier integerValue], 0, YES)];
+    }
+    
+    return [NSJSONSerialization dataWithJSONObject:mutableRepresentations options:0 error:nil];
+}
+
++ (NSData *)JSONDataForSongsOfArtistWithIdentifier:(NSUInteger)artistIdentifier
+                                     numberOfSongs:(NSUInteger)numberOfSongs
+{
+    return [NSJSONSerialization dataWithJSONObject:AFBenchmarkSongRepresentations(artistIdentifier, numberOfSongs) options:0 error:nil];
+}
+
+@end
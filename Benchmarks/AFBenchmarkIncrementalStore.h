@@ -0,0 +1,47 @@
+// AFBenchmarkIncrementalStore.h
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "AFIncrementalStore.h"
+#import "AFRESTClient.h"
+
+/**
+ `AFBenchmarkIncrementalStore` is the incremental store measured by the benchmarks. Its model, built in code, has an `Artist` entity with `name` and `artistDescription` attributes and a to-many `songs` relationship, and a `Song` entity with a `title` attribute and a to-one `artist` relationship.
+ */
+@interface AFBenchmarkIncrementalStore : AFIncrementalStore
+@end
+
+/**
+ `AFBenchmarkAPIClient` is the HTTP client of the incremental store measured by the benchmarks. Remote attribute and relationship values are only fetched for the cases that measure faults, and the attribute faults of several artists are fetched together with `GET /artists?ids=1,2,3`.
+ */
+@interface AFBenchmarkAPIClient : AFRESTClient
+
+/**
+ Whether attribute faults request the values of their objects. `NO` by default.
+ */
+@property (nonatomic, assign) BOOL fetchesRemoteAttributeValues;
+
+/**
+ Whether relationship faults request the values of their relationships. `NO` by default.
+ */
+@property (nonatomic, assign) BOOL fetchesRemoteRelationshipValues;
+
+@end
@@ -0,0 +1,132 @@
+// AFBenchmarkIncrementalStore.m
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "AFBenchmarkIncrementalStore.h"
+
+static NSAttributeDescription * AFBenchmarkStringAttributeWithName(NSString *name) {
+    NSAttributeDescription *attribute = [[NSAttributeDescription alloc] init];
+    attribute.name = name;
+    attribute.attributeType = NSStringAttributeType;
+    attribute.optional = YES;
+    
+    return attribute;
+}
+
+@implementation AFBenchmarkIncrementalStore
+
++ (void)initialize {
+    [NSPersistentStoreCoordinator registerStoreClass:self forStoreType:[self type]];
+}
+
++ (NSString *)type {
+    return NSStringFromClass(self);
+}
+
++ (NSManagedObjectModel *)model {
+    static NSManagedObjectModel *_model = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSEntityDescription *artistEntity = [[NSEntityDescription alloc] init];
+        artistEntity.name = @"Artist";
+        artistEntity.managedObjectClassName = NSStringFromClass([NSManagedObject class]);
+        
+        NSEntityDescription *songEntity = [[NSEntityDescription alloc] init];
+        songEntity.name = @"Song";
+        songEntity.managedObjectClassName = NSStringFromClass([NSManagedObject class]);
+        
+        NSRelationshipDescription *songsRelationship = [[NSRelationshipDescription alloc] init];
+        songsRelationship.name = @"songs";
+        songsRelationship.destinationEntity = songEntity;
+        songsRelationship.minCount = 0;
+        songsRelationship.maxCount = 0;
+        songsRelationship.deleteRule = NSCascadeDeleteRule;
+        songsRelationship.optional = YES;
+        
+        NSRelationshipDescription *artistRelationship = [[NSRelationshipDescription alloc] init];
+        artistRelationship.name = @"artist";
+        artistRelationship.destinationEntity = artistEntity;
+        artistRelationship.minCount = 0;
+        artistRelationship.maxCount = 1;
+        artistRelationship.deleteRule = NSNullifyDeleteRule;
+        artistRelationship.optional = YES;
+        
+        songsRelationship.inverseRelationship = artistRelationship;
+        artistRelationship.inverseRelationship = songsRelationship;
+        
+        artistEntity.properties = [NSArray arrayWithObjects:AFBenchmarkStringAttributeWithName(@"name"), AFBenchmarkStringAttributeWithName(@"artistDescription"), songsRelationship, nil];
+        songEntity.properties = [NSArray arrayWithObjects:AFBenchmarkStringAttributeWithName(@"title"), artistRelationship, nil];
+        
+        _model = [[NSManagedObjectModel alloc] init];
+        _model.entities = [NSArray arrayWithObjects:artistEntity, songEntity, nil];
+    });
+    
+    return _model;
+}
+
+@end
+
+#pragma mark -
+
+@implementation AFBenchmarkAPIClient
+@synthesize fetchesRemoteAttributeValues = _fetchesRemoteAttributeValues;
+@synthesize fetchesRemoteRelationshipValues = _fetchesRemoteRelationshipValues;
+
+- (id)initWithBaseURL:(NSURL *)url {
+    self = [super initWithBaseURL:url];
+    if (!self) {
+        return nil;
+    }
+    
+    [self registerHTTPOperationClass:[AFJSONRequestOperation class]];
+    [self setDefaultHeader:@"Accept" value:@"application/json"];
+    
+    return self;
+}
+
+- (BOOL)shouldFetchRemoteAttributeValuesForObjectWithID:(NSManagedObjectID *)objectID
+                                 inManagedObjectContext:(NSManagedObjectContext *)context
+{
+    return self.fetchesRemoteAttributeValues;
+}
+
+- (NSURLRequest *)requestWithMethod:(NSString *)method
+              pathForObjectsWithIDs:(NSArray *)objectIDs
+                        withContext:(NSManagedObjectContext *)context
+{
+    NSMutableArray *mutableResourceIdentifiers = [NSMutableArray arrayWithCapacity:[objectIDs count]];
+    for (NSManagedObjectID *objectID in objectIDs) {
+        NSString *resourceIdentifier = [(NSIncrementalStore *)objectID.persistentStore referenceObjectForObjectID:objectID];
+        [mutableResourceIdentifiers addObject:[resourceIdentifier lastPathComponent]];
+    }
+    
+    NSEntityDescription *entity = [[objectIDs lastObject] entity];
+    return [self requestWithMethod:method path:[self pathForEntity:entity] parameters:[NSDictionary dictionaryWithObject:[mutableResourceIdentifiers componentsJoinedByString:@","] forKey:@"ids"]];
+}
+
+- (BOOL)shouldFetchRemoteValuesForRelationship:(NSRelationshipDescription *)relationship
+                               forObjectWithID:(NSManagedObjectID *)objectID
+                        inManagedObjectContext:(NSManagedObjectContext *)context
+{
+    return self.fetchesRemoteRelationshipValues;
+}
+
+@end
@@ -0,0 +1,61 @@
+// AFBenchmarkMeasurement.h
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ `AFBenchmarkMeasurement` records the wall time, the peak memory, and the number of SQLite statements of a block of work, along with the number of requests answered by `AFBenchmarkURLProtocol` while it ran.
+ 
+ @discussion SQLite statements are counted from the `CoreData: sql:` lines that Core Data logs to the standard error when the `com.apple.CoreData.SQLDebug` user default is set to `1`, which is captured while the block runs. Peak memory is the highest resident size of the process, sampled every 10 milliseconds, above its resident size when the block started.
+ */
+@interface AFBenchmarkMeasurement : NSObject
+
+/**
+ The wall time taken by the block.
+ */
+@property (readonly, nonatomic, assign) NSTimeInterval duration;
+
+/**
+ The growth of the resident size of the process at its peak, in bytes.
+ */
+@property (readonly, nonatomic, assign) unsigned long long peakMemoryGrowth;
+
+/**
+ The number of `SELECT`, `INSERT`, `UPDATE` and `DELETE` statements run against SQLite stores.
+ */
+@property (readonly, nonatomic, assign) NSUInteger numberOfSQLStatements;
+
+/**
+ The number of HTTP requests answered.
+ */
+@property (readonly, nonatomic, assign) NSUInteger numberOfRequests;
+
+/**
+ Runs the specified block on the current thread, and measures it.
+ 
+ @param block The block to measure, which must only return once the work it starts has completed.
+ 
+ @return The measurement of the block.
+ */
++ (AFBenchmarkMeasurement *)measurementOfBlock:(void (^)(void))block;
+
+@end
@@ -0,0 +1,150 @@
+// AFBenchmarkMeasurement.m
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "AFBenchmarkMeasurement.h"
+#import "AFBenchmarkURLProtocol.h"
+
+#import <mach/mach.h>
+#import <unistd.h>
+
+static NSTimeInterval const kAFBenchmarkMemorySamplingInterval = 0.01;
+
+static unsigned long long AFResidentMemorySize(void) {
+    struct task_basic_info info;
+    mach_msg_type_number_t count = TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    
+    return info.resident_size;
+}
+
+static NSUInteger AFNumberOfSQLStatementsInLine(const char *line) {
+    static const char *prefix = "CoreData: sql: ";
+    const char *statement = strstr(line, prefix);
+    if (!statement) {
+        return 0;
+    }
+    
+    statement += strlen(prefix);
+    if (strncmp(statement, "SELECT", 6) == 0 || strncmp(statement, "INSERT", 6) == 0 || strncmp(statement, "UPDATE", 6) == 0 || strncmp(statement, "DELETE", 6) == 0) {
+        return 1;
+    }
+    
+    return 0;
+}
+
+@interface AFBenchmarkMeasurement ()
+@property (readwrite, nonatomic, assign) NSTimeInterval duration;
+@property (readwrite, nonatomic, assign) unsigned long long peakMemoryGrowth;
+@property (readwrite, nonatomic, assign) NSUInteger numberOfSQLStatements;
+@property (readwrite, nonatomic, assign) NSUInteger numberOfRequests;
+@end
+
+@implementation AFBenchmarkMeasurement
+@synthesize duration = _duration;
+@synthesize peakMemoryGrowth = _peakMemoryGrowth;
+@synthesize numberOfSQLStatements = _numberOfSQLStatements;
+@synthesize numberOfRequests = _numberOfRequests;
+
++ (AFBenchmarkMeasurement *)measurementOfBlock:(void (^)(void))block {
+    // The standard error is redirected into a pipe while the block runs, and the SQL statements logged to it are counted a line at a time, rather than kept, so that counting them doesn't add to the memory being measured
+    int pipeFileDescriptors[2];
+    if (pipe(pipeFileDescriptors) != 0) {
+        return nil;
+    }
+    
+    fflush(stderr);
+    int standardErrorFileDescriptor = dup(STDERR_FILENO);
+    dup2(pipeFileDescriptors[1], STDERR_FILENO);
+    close(pipeFileDescriptors[1]);
+    
+    int readFileDescriptor = pipeFileDescriptors[0];
+    __block NSUInteger numberOfSQLStatements = 0;
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSMutableData *mutableLine = [NSMutableData data];
+        char buffer[4096];
+        ssize_t length = 0;
+        while ((length = read(readFileDescriptor, buffer, sizeof(buffer))) > 0) {
+            char *start = buffer;
+            char *end = buffer + length;
+            char *newline = NULL;
+            while ((newline = memchr(start, '\n', (size_t)(end - start)))) {
+                [mutableLine appendBytes:start length:(NSUInteger)(newline - start)];
+                [mutableLine appendBytes:"" length:1];
+                numberOfSQLStatements += AFNumberOfSQLStatementsInLine([mutableLine bytes]);
+                [mutableLine setLength:0];
+                start = newline + 1;
+            }
+            [mutableLine appendBytes:start length:(NSUInteger)(end - start)];
+        }
+        close(readFileDescriptor);
+    });
+    
+    unsigned long long initialResidentMemorySize = AFResidentMemorySize();
+    __block unsigned long long peakResidentMemorySize = initialResidentMemorySize;
+    dispatch_queue_t samplingQueue = dispatch_queue_create("com.alamofire.incremental-store.benchmarks.memory-sampling", DISPATCH_QUEUE_SERIAL);
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, samplingQueue);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, 0), (uint64_t)(kAFBenchmarkMemorySamplingInterval * NSEC_PER_SEC), 0);
+    dispatch_source_set_event_handler(timer, ^{
+        peakResidentMemorySize = MAX(peakResidentMemorySize, AFResidentMemorySize());
+    });
+    dispatch_resume(timer);
+    
+    [AFBenchmarkURLProtocol resetNumberOfRequests];
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    block();
+    NSTimeInterval duration = CFAbsoluteTimeGetCurrent() - startTime;
+    NSUInteger numberOfRequests = [AFBenchmarkURLProtocol numberOfRequests];
+    
+    dispatch_source_cancel(timer);
+    dispatch_sync(samplingQueue, ^{
+        peakResidentMemorySize = MAX(peakResidentMemorySize, AFResidentMemorySize());
+    });
+    
+    // Restoring the standard error closes the last write end of the pipe, which lets the reader finish
+    fflush(stderr);
+    dup2(standardErrorFileDescriptor, STDERR_FILENO);
+    close(standardErrorFileDescriptor);
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    
+#if !OS_OBJECT_USE_OBJC
+    dispatch_release(timer);
+    dispatch_release(samplingQueue);
+    dispatch_release(group);
+#endif
+    
+    AFBenchmarkMeasurement *measurement = [[AFBenchmarkMeasurement alloc] init];
+    measurement.duration = duration;
+    measurement.peakMemoryGrowth = peakResidentMemorySize - initialResidentMemorySize;
+    measurement.numberOfSQLStatements = numberOfSQLStatements;
+    measurement.numberOfRequests = numberOfRequests;
+    
+    return measurement;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%.3f s, %.1f MB peak memory growth, %lu SQL statements, %lu requests", self.duration, (double)self.peakMemoryGrowth / (1024.0 * 1024.0), (unsigned long)self.numberOfSQLStatements, (unsigned long)self.numberOfRequests];
+}
+
+@end
@@ -0,0 +1,55 @@
+// AFBenchmarkURLProtocol.h
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ A block returning the body of the response to a request, and optionally setting its status code, which is `200` by default. Returning `nil` with the default status code responds with `404 Not Found`.
+ */
+typedef NSData * (^AFBenchmarkResponseHandler)(NSURLRequest *request, NSInteger *statusCode);
+
+/**
+ The host of the requests answered by `AFBenchmarkURLProtocol`.
+ */
+extern NSString * const AFBenchmarkURLProtocolHost;
+
+/**
+ `AFBenchmarkURLProtocol` answers requests to `AFBenchmarkURLProtocolHost` with fixture JSON returned by a handler, without going to the network, so that benchmarks measure the store rather than the connection.
+ */
+@interface AFBenchmarkURLProtocol : NSURLProtocol
+
+/**
+ Sets the handler for the requests answered from now on, or `nil` to answer all of them with `404 Not Found`.
+ */
++ (void)setResponseHandler:(AFBenchmarkResponseHandler)handler;
+
+/**
+ The number of requests answered since the last call to `+resetNumberOfRequests`.
+ */
++ (NSUInteger)numberOfRequests;
+
+/**
+ Resets the number of requests answered to `0`.
+ */
++ (void)resetNumberOfRequests;
+
+@end
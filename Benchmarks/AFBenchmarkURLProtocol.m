@@ -0,0 +1,98 @@
+// AFBenchmarkURLProtocol.m
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "AFBenchmarkURLProtocol.h"
+
+NSString * const AFBenchmarkURLProtocolHost = @"benchmark.local";
+
+static AFBenchmarkResponseHandler _responseHandler = nil;
+static NSUInteger _numberOfRequests = 0;
+
+static dispatch_queue_t AFBenchmarkURLProtocolQueue(void) {
+    static dispatch_queue_t _queue = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _queue = dispatch_queue_create("com.alamofire.incremental-store.benchmarks.url-protocol", DISPATCH_QUEUE_SERIAL);
+    });
+    
+    return _queue;
+}
+
+@implementation AFBenchmarkURLProtocol
+
++ (void)setResponseHandler:(AFBenchmarkResponseHandler)handler {
+    dispatch_sync(AFBenchmarkURLProtocolQueue(), ^{
+        _responseHandler = [handler copy];
+    });
+}
+
++ (NSUInteger)numberOfRequests {
+    __block NSUInteger numberOfRequests = 0;
+    dispatch_sync(AFBenchmarkURLProtocolQueue(), ^{
+        numberOfRequests = _numberOfRequests;
+    });
+    
+    return numberOfRequests;
+}
+
++ (void)resetNumberOfRequests {
+    dispatch_sync(AFBenchmarkURLProtocolQueue(), ^{
+        _numberOfRequests = 0;
+    });
+}
+
+#pragma mark - NSURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    return [[[request URL] host] isEqualToString:AFBenchmarkURLProtocolHost];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    __block AFBenchmarkResponseHandler handler = nil;
+    dispatch_sync(AFBenchmarkURLProtocolQueue(), ^{
+        handler = _responseHandler;
+        _numberOfRequests++;
+    });
+    
+    NSInteger statusCode = 200;
+    NSData *data = handler ? handler([self request], &statusCode) : nil;
+    if (!data && statusCode == 200) {
+        statusCode = 404;
+    }
+    
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[[self request] URL] statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:[NSDictionary dictionaryWithObject:@"application/json" forKey:@"Content-Type"]];
+    [[self client] URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    if (data) {
+        [[self client] URLProtocol:self didLoadData:data];
+    }
+    [[self client] URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+    // Responses are delivered in full from `-startLoading`, so there is nothing left to stop
+}
+
+@end
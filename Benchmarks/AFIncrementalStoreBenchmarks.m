@@ -0,0 +1,304 @@
+// AFIncrementalStoreBenchmarks.m
+//
+// Copyright (c) 2012 Mattt Thompson (http://mattt.me)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <SenTestingKit/SenTestingKit.h>
+
+#import "AFBenchmarkIncrementalStore.h"
+#import "AFBenchmarkFixtures.h"
+#import "AFBenchmarkMeasurement.h"
+#import "AFBenchmarkURLProtocol.h"
+
+static NSTimeInterval const kAFBenchmarkTimeoutInterval = 600.0;
+static NSUInteger const kAFBenchmarkNumberOfSongsPerArtist = 10;
+
+static NSArray * AFBenchmarkIdentifiersInQueryOfRequest(NSURLRequest *request) {
+    for (NSString *parameter in [[[request URL] query] componentsSeparatedByString:@"&"]) {
+        if ([parameter hasPrefix:@"ids="]) {
+            return [[[parameter substringFromIndex:4] stringByReplacingPercentEscapesUsingEncoding:NSUTF8StringEncoding] componentsSeparatedByString:@","];
+        }
+    }
+    
+    return nil;
+}
+
+/**
+ Measures importing collections, embedded relationships, attribute faults, relationship faults, and refreshes with nothing changed, with responses replayed from fixture JSON. Each case logs its wall time, peak memory growth, and number of SQLite statements, in a line starting with `[Benchmark]`.
+ */
+@interface AFIncrementalStoreBenchmarks : SenTestCase
+@property (nonatomic, strong) NSPersistentStoreCoordinator *persistentStoreCoordinator;
+@property (nonatomic, strong) AFIncrementalStore *incrementalStore;
+@property (nonatomic, strong) AFBenchmarkAPIClient *HTTPClient;
+@property (nonatomic, strong) NSManagedObjectContext *managedObjectContext;
+
+- (BOOL)waitUntil:(BOOL (^)(void))condition;
+- (void)prefetchArtists;
+- (NSArray *)fetchArtists;
+- (NSUInteger)numberOfStoredObjectsOfEntityName:(NSString *)entityName;
+- (void)reportMeasurement:(AFBenchmarkMeasurement *)measurement
+                   ofCase:(NSString *)name;
+- (void)measureImportOfNumberOfArtists:(NSUInteger)numberOfArtists
+                         numberOfSongs:(NSUInteger)numberOfSongs;
+@end
+
+@implementation AFIncrementalStoreBenchmarks
+@synthesize persistentStoreCoordinator = _persistentStoreCoordinator;
+@synthesize incrementalStore = _incrementalStore;
+@synthesize HTTPClient = _HTTPClient;
+@synthesize managedObjectContext = _managedObjectContext;
+
++ (void)initialize {
+    [NSURLProtocol registerClass:[AFBenchmarkURLProtocol class]];
+    
+    // Core Data logs each SQL statement to the standard error, where they are counted, as with the `-com.apple.CoreData.SQLDebug 1` launch argument
+    [[NSUserDefaults standardUserDefaults] setInteger:1 forKey:@"com.apple.CoreData.SQLDebug"];
+}
+
+- (void)setUp {
+    [super setUp];
+    
+    NSString *storePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"AFIncrementalStoreBenchmarks.sqlite"];
+    for (NSString *suffix in [NSArray arrayWithObjects:@"", @"-shm", @"-wal", nil]) {
+        [[NSFileManager defaultManager] removeItemAtPath:[storePath stringByAppendingString:suffix] error:nil];
+    }
+    
+    self.persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:[AFBenchmarkIncrementalStore model]];
+    
+    NSDictionary *options = [NSDictionary dictionaryWithObjectsAndKeys:NSSQLiteStoreType, AFIncrementalStoreBackingStoreTypeOption, [NSURL fileURLWithPath:storePath], AFIncrementalStoreBackingStoreURLOption, nil];
+    NSError *error = nil;
+    self.incrementalStore = (AFIncrementalStore *)[self.persistentStoreCoordinator addPersistentStoreWithType:[AFBenchmarkIncrementalStore type] configuration:nil URL:nil options:options error:&error];
+    STAssertNotNil(self.incrementalStore, @"Could not add the incremental store: %@", error);
+    
+    self.HTTPClient = [[AFBenchmarkAPIClient alloc] initWithBaseURL:[NSURL URLWithString:[NSString stringWithFormat:@"http://%@/", AFBenchmarkURLProtocolHost]]];
+    self.incrementalStore.HTTPClient = self.HTTPClient;
+    
+    self.managedObjectContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSMainQueueConcurrencyType];
+    self.managedObjectContext.persistentStoreCoordinator = self.persistentStoreCoordinator;
+}
+
+- (void)tearDown {
+    [self.HTTPClient.operationQueue cancelAllOperations];
+    [AFBenchmarkURLProtocol setResponseHandler:nil];
+    
+    self.managedObjectContext = nil;
+    self.HTTPClient = nil;
+    self.incrementalStore = nil;
+    self.persistentStoreCoordinator = nil;
+    
+    [super tearDown];
+}
+
+#pragma mark -
+
+- (BOOL)waitUntil:(BOOL (^)(void))condition {
+    // Responses and merges are delivered on the main queue, which is drained by running the main run loop
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:kAFBenchmarkTimeoutInterval];
+    while (!condition()) {
+        if ([timeoutDate timeIntervalSinceNow] < 0.0) {
+            return NO;
+        }
+        
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    
+    return YES;
+}
+
+- (void)prefetchArtists {
+    __block BOOL didPrefetch = NO;
+    [self.incrementalStore prefetchResultsOfFetchRequests:[NSArray arrayWithObject:[NSFetchRequest fetchRequestWithEntityName:@"Artist"]] completion:^{
+        didPrefetch = YES;
+    }];
+    
+    STAssertTrue([self waitUntil:^BOOL{ return didPrefetch; }], @"Timed out prefetching artists");
+}
+
+- (NSArray *)fetchArtists {
+    NSFetchRequest *fetchRequest = [NSFetchRequest fetchRequestWithEntityName:@"Artist"];
+    NSError *error = nil;
+    NSArray *artists = [self.managedObjectContext executeFetchRequest:fetchRequest error:&error];
+    STAssertNotNil(artists, @"Could not fetch artists: %@", error);
+    
+    return artists;
+}
+
+- (NSUInteger)numberOfStoredObjectsOfEntityName:(NSString *)entityName {
+    // Objects are counted in the backing store, so that counting them requests nothing
+    NSManagedObjectContext *backingContext = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    backingContext.persistentStoreCoordinator = self.incrementalStore.backingPersistentStoreCoordinator;
+    
+    __block NSUInteger numberOfObjects = 0;
+    [backingContext performBlockAndWait:^{
+        numberOfObjects = [backingContext countForFetchRequest:[NSFetchRequest fetchRequestWithEntityName:entityName] error:nil];
+    }];
+    
+    return numberOfObjects;
+}
+
+- (void)reportMeasurement:(AFBenchmarkMeasurement *)measurement
+                   ofCase:(NSString *)name
+{
+    NSLog(@"[Benchmark] %@: %@", name, measurement);
+}
+
+- (void)measureImportOfNumberOfArtists:(NSUInteger)numberOfArtists
+                         numberOfSongs:(NSUInteger)numberOfSongs
+{
+    NSData *data = [AFBenchmarkFixtures JSONDataForArtistsWithIdentifiersInRange:NSMakeRange(1, numberOfArtists) numberOfSongs:numberOfSongs includesDescriptions:YES];
+    [AFBenchmarkURLProtocol setResponseHandler:^NSData *(__unused NSURLRequest *request, __unused NSInteger *statusCode) {
+        return data;
+    }];
+    
+    AFBenchmarkMeasurement *measurement = [AFBenchmarkMeasurement measurementOfBlock:^{
+        [self prefetchArtists];
+    }];
+    
+    STAssertEquals([self numberOfStoredObjectsOfEntityName:@"Artist"], numberOfArtists, @"Not all artists were imported");
+    STAssertEquals([self numberOfStoredObjectsOfEntityName:@"Song"], numberOfArtists * numberOfSongs, @"Not all songs were imported");
+    [self reportMeasurement:measurement ofCase:[NSString stringWithFormat:@"Import of %lu artists with %lu songs each", (unsigned long)numberOfArtists, (unsigned long)numberOfSongs]];
+}
+
+#pragma mark - Collection Imports
+
+- (void)testImportOf100Artists {
+    [self measureImportOfNumberOfArtists:100 numberOfSongs:0];
+}
+
+- (void)testImportOf10000Artists {
+    [self measureImportOfNumberOfArtists:10000 numberOfSongs:0];
+}
+
+- (void)testImportOf100000Artists {
+    [self measureImportOfNumberOfArtists:100000 numberOfSongs:0];
+}
+
+#pragma mark - Nested Relationship Imports
+
+- (void)testImportOfArtistsWithEmbeddedSongs {
+    [self measureImportOfNumberOfArtists:1000 numberOfSongs:kAFBenchmarkNumberOfSongsPerArtist];
+}
+
+#pragma mark - Faults
+
+- (void)testAttributeFaultStorm {
+    NSUInteger numberOfArtists = 1000;
+    NSData *data = [AFBenchmarkFixtures JSONDataForArtistsWithIdentifiersInRange:NSMakeRange(1, numberOfArtists) numberOfSongs:0 includesDescriptions:NO];
+    [AFBenchmarkURLProtocol setResponseHandler:^NSData *(__unused NSURLRequest *request, __unused NSInteger *statusCode) {
+        return data;
+    }];
+    [self prefetchArtists];
+    
+    // Collections are answered with `304 Not Modified` from now on, so that only the attribute faults import anything
+    [AFBenchmarkURLProtocol setResponseHandler:^NSData *(NSURLRequest *request, NSInteger *statusCode) {
+        NSArray *identifiers = AFBenchmarkIdentifiersInQueryOfRequest(request);
+        if (!identifiers) {
+            *statusCode = 304;
+            return nil;
+        }
+        
+        return [AFBenchmarkFixtures JSONDataForArtistsWithIdentifiers:identifiers];
+    }];
+    self.HTTPClient.fetchesRemoteAttributeValues = YES;
+    
+    __block NSArray *artists = nil;
+    AFBenchmarkMeasurement *measurement = [AFBenchmarkMeasurement measurementOfBlock:^{
+        artists = [self fetchArtists];
+        for (NSManagedObject *artist in artists) {
+            [artist valueForKey:@"artistDescription"];
+        }
+        
+        STAssertTrue([self waitUntil:^BOOL{
+            for (NSManagedObject *artist in artists) {
+                if (![artist valueForKey:@"artistDescription"]) {
+                    return NO;
+                }
+            }
+            
+            return YES;
+        }], @"Timed out fulfilling attribute faults");
+    }];
+    
+    STAssertEquals([artists count], numberOfArtists, @"Not all artists were fetched");
+    [self reportMeasurement:measurement ofCase:[NSString stringWithFormat:@"Attribute faults of %lu artists", (unsigned long)numberOfArtists]];
+}
+
+- (void)testRelationshipFaults {
+    NSUInteger numberOfArtists = 200;
+    NSData *data = [AFBenchmarkFixtures JSONDataForArtistsWithIdentifiersInRange:NSMakeRange(1, numberOfArtists) numberOfSongs:0 includesDescriptions:YES];
+    [AFBenchmarkURLProtocol setResponseHandler:^NSData *(__unused NSURLRequest *request, __unused NSInteger *statusCode) {
+        return data;
+    }];
+    [self prefetchArtists];
+    
+    // Collections are answered with `304 Not Modified` from now on, and `/artists/:id/songs` with the songs of the artist
+    [AFBenchmarkURLProtocol setResponseHandler:^NSData *(NSURLRequest *request, NSInteger *statusCode) {
+        NSArray *pathComponents = [[request URL] pathComponents];
+        if ([pathComponents count] != 4 || ![[pathComponents lastObject] isEqualToString:@"songs"]) {
+            *statusCode = 304;
+            return nil;
+        }
+        
+        return [AFBenchmarkFixtures JSONDataForSongsOfArtistWithIdentifier:[[pathComponents objectAtIndex:2] integerValue] numberOfSongs:kAFBenchmarkNumberOfSongsPerArtist];
+    }];
+    self.HTTPClient.fetchesRemoteRelationshipValues = YES;
+    
+    __block NSArray *artists = nil;
+    AFBenchmarkMeasurement *measurement = [AFBenchmarkMeasurement measurementOfBlock:^{
+        artists = [self fetchArtists];
+        for (NSManagedObject *artist in artists) {
+            [[artist valueForKey:@"songs"] count];
+        }
+        
+        STAssertTrue([self waitUntil:^BOOL{
+            for (NSManagedObject *artist in artists) {
+                if ([[artist valueForKey:@"songs"] count] < kAFBenchmarkNumberOfSongsPerArtist) {
+                    return NO;
+                }
+            }
+            
+            return YES;
+        }], @"Timed out fulfilling relationship faults");
+    }];
+    
+    STAssertEquals([self numberOfStoredObjectsOfEntityName:@"Song"], numberOfArtists * kAFBenchmarkNumberOfSongsPerArtist, @"Not all songs were imported");
+    [self reportMeasurement:measurement ofCase:[NSString stringWithFormat:@"Relationship faults of %lu artists with %lu songs each", (unsigned long)numberOfArtists, (unsigned long)kAFBenchmarkNumberOfSongsPerArtist]];
+}
+
+#pragma mark - Refreshes
+
+- (void)testRefreshOfUnchangedArtists {
+    NSUInteger numberOfArtists = 10000;
+    NSData *data = [AFBenchmarkFixtures JSONDataForArtistsWithIdentifiersInRange:NSMakeRange(1, numberOfArtists) numberOfSongs:0 includesDescriptions:YES];
+    [AFBenchmarkURLProtocol setResponseHandler:^NSData *(__unused NSURLRequest *request, __unused NSInteger *statusCode) {
+        return data;
+    }];
+    [self prefetchArtists];
+    
+    // The same representations are served again, without validators, so that every one of them is compared with what is stored
+    AFBenchmarkMeasurement *measurement = [AFBenchmarkMeasurement measurementOfBlock:^{
+        [self prefetchArtists];
+    }];
+    
+    STAssertEquals([self numberOfStoredObjectsOfEntityName:@"Artist"], numberOfArtists, @"Artists were duplicated by the refresh");
+    [self reportMeasurement:measurement ofCase:[NSString stringWithFormat:@"Refresh of %lu unchanged artists", (unsigned long)numberOfArtists]];
+}
+
+@end
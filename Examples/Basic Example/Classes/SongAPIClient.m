@@ -46,28 +46,36 @@ static NSString * const kAFIncrementalStoreExampleAPIBaseURLString = @"http://af
     [self registerHTTPOperationClass:[AFJSONRequestOperation class]];
     [self setDefaultHeader:@"Accept" value:@"application/json"];
     
+    [self registerAttributeNames:[NSDictionary dictionaryWithObject:@"artistDescription" forKey:@"description"] forEntityName:@"Artist"];
+    
     return self;
 }
 
-- (NSDictionary *)attributesForRepresentation:(NSDictionary *)representation
-                                     ofEntity:(NSEntityDescription *)entity
-                                 fromResponse:(NSHTTPURLResponse *)response 
+- (BOOL)shouldFetchRemoteAttributeValuesForObjectWithID:(NSManagedObjectID *)objectID inManagedObjectContext:(NSManagedObjectContext *)context {
+    return [[[objectID entity] name] isEqualToString:@"Artist"];
+}
+
+// Attribute faults on several artists are fetched together, with a single `GET /artists?ids=1,2,3` request
+- (NSURLRequest *)requestWithMethod:(NSString *)method
+              pathForObjectsWithIDs:(NSArray *)objectIDs
+                        withContext:(NSManagedObjectContext *)context
 {
-    NSMutableDictionary *mutablePropertyValues = [[super attributesForRepresentation:representation ofEntity:entity fromResponse:response] mutableCopy];
-    if ([entity.name isEqualToString:@"Artist"]) {
-        NSString *description = [representation valueForKey:@"description"];
-        [mutablePropertyValues setValue:description forKey:@"artistDescription"];
+    NSMutableArray *mutableResourceIdentifiers = [NSMutableArray arrayWithCapacity:[objectIDs count]];
+    for (NSManagedObjectID *objectID in objectIDs) {
+        NSString *resourceIdentifier = [(NSIncrementalStore *)objectID.persistentStore referenceObjectForObjectID:objectID];
+        [mutableResourceIdentifiers addObject:[resourceIdentifier lastPathComponent]];
     }
     
-    return mutablePropertyValues;
+    NSEntityDescription *entity = [[objectIDs lastObject] entity];
+    return [self requestWithMethod:method path:[self pathForEntity:entity] parameters:[NSDictionary dictionaryWithObject:[mutableResourceIdentifiers componentsJoinedByString:@","] forKey:@"ids"]];
 }
 
-- (BOOL)shouldFetchRemoteAttributeValuesForObjectWithID:(NSManagedObjectID *)objectID inManagedObjectContext:(NSManagedObjectContext *)context {
+- (BOOL)shouldFetchRemoteValuesForRelationship:(NSRelationshipDescription *)relationship forObjectWithID:(NSManagedObjectID *)objectID inManagedObjectContext:(NSManagedObjectContext *)context {
     return [[[objectID entity] name] isEqualToString:@"Artist"];
 }
 
-- (BOOL)shouldFetchRemoteValuesForRelationship:(NSRelationshipDescription *)relationship forObjectWithID:(NSManagedObjectID *)objectID inManagedObjectContext:(NSManagedObjectContext *)context {
-    return [[[objectID entity] name] isEqualToString:@"Artist"];
+- (NSTimeInterval)timeToLiveForEntity:(NSEntityDescription *)entity {
+    return 60.0 * 5.0;
 }
 
 @end
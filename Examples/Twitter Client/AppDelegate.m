@@ -106,17 +106,17 @@
     
     __persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:[self managedObjectModel]];
     
-    AFIncrementalStore *incrementalStore = (AFIncrementalStore *)[__persistentStoreCoordinator addPersistentStoreWithType:[TwitterIncrementalStore type] configuration:nil URL:nil options:nil error:nil];
-    
     NSURL *storeURL = [[self applicationDocumentsDirectory] URLByAppendingPathComponent:@"Twitter.sqlite"];
     
     NSDictionary *options = @{
+        AFIncrementalStoreBackingStoreTypeOption : NSSQLiteStoreType,
+        AFIncrementalStoreBackingStoreURLOption : storeURL,
         NSInferMappingModelAutomaticallyOption : @(YES),
         NSMigratePersistentStoresAutomaticallyOption: @(YES)
     };
     
     NSError *error = nil;
-    if (![incrementalStore.backingPersistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType configuration:nil URL:storeURL options:options error:&error]) {
+    if (![__persistentStoreCoordinator addPersistentStoreWithType:[TwitterIncrementalStore type] configuration:nil URL:nil options:options error:&error]) {
         NSLog(@"Unresolved error %@, %@", error, [error userInfo]);
         abort();
     }
@@ -56,6 +56,7 @@
     NSFetchRequest *fetchRequest = [NSFetchRequest fetchRequestWithEntityName:@"Tweet"];
     fetchRequest.sortDescriptors = [NSArray arrayWithObject:[NSSortDescriptor sortDescriptorWithKey:@"tweetID" ascending:NO]];
     fetchRequest.fetchLimit = 50;
+    fetchRequest.fetchBatchSize = 20;
     _fetchedResultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:fetchRequest managedObjectContext:[(id)[[UIApplication sharedApplication] delegate] managedObjectContext] sectionNameKeyPath:nil cacheName:@"PublicTimeline"];
     _fetchedResultsController.delegate = self;
     [self refetchData];
@@ -45,6 +45,10 @@ static NSString * const kAFTwitterAPIBaseURLString = @"http://api.twitter.com/1/
     [self registerHTTPOperationClass:[AFJSONRequestOperation class]];
     [self setDefaultHeader:@"Accept" value:@"application/json"];
     
+    self.dateFormats = [NSArray arrayWithObject:@"EEE MMM dd HH:mm:ss Z yyyy"];
+    [self registerAttributeNames:[NSDictionary dictionaryWithObjectsAndKeys:@"tweetID", @"id", @"createdAt", @"created_at", nil] forEntityName:@"Tweet"];
+    [self registerAttributeNames:[NSDictionary dictionaryWithObjectsAndKeys:@"userID", @"id", @"username", @"screen_name", @"profileImageURLString", @"profile_image_url", nil] forEntityName:@"User"];
+    
     return self;
 }
 
@@ -61,20 +65,37 @@ static NSString * const kAFTwitterAPIBaseURLString = @"http://api.twitter.com/1/
     return mutableURLRequest;
 }
 
-- (NSDictionary *)attributesForRepresentation:(NSDictionary *)representation 
-                                         ofEntity:(NSEntityDescription *)entity 
-                                     fromResponse:(NSHTTPURLResponse *)response 
+- (NSURLRequest *)requestForFetchRequest:(NSFetchRequest *)fetchRequest
+                          withPageCursor:(id)pageCursor
+                             withContext:(NSManagedObjectContext *)context
 {
-    NSMutableDictionary *mutablePropertyValues = [[super attributesForRepresentation:representation ofEntity:entity fromResponse:response] mutableCopy];
-    if ([entity.name isEqualToString:@"Tweet"]) {
-        [mutablePropertyValues setValue:[representation valueForKey:@"id"] forKey:@"tweetID"];
-    } else if ([entity.name isEqualToString:@"User"]) {
-        [mutablePropertyValues setValue:[representation valueForKey:@"id"] forKey:@"userID"];
-        [mutablePropertyValues setValue:[representation valueForKey:@"screen_name"] forKey:@"username"];
-        [mutablePropertyValues setValue:[representation valueForKey:@"profile_image_url"] forKey:@"profileImageURLString"];
+    NSMutableURLRequest *mutableURLRequest = nil;
+    if ([fetchRequest.entityName isEqualToString:@"Tweet"]) {
+        NSMutableDictionary *mutableParameters = [NSMutableDictionary dictionary];
+        if (fetchRequest.fetchBatchSize > 0) {
+            [mutableParameters setValue:[NSNumber numberWithUnsignedInteger:fetchRequest.fetchBatchSize] forKey:@"count"];
+        }
+        [mutableParameters setValue:pageCursor forKey:@"max_id"];
+        
+        mutableURLRequest = [self requestWithMethod:@"GET" path:@"statuses/public_timeline.json" parameters:mutableParameters];
     }
     
-    return mutablePropertyValues;
+    return mutableURLRequest;
+}
+
+- (id)pageCursorFollowingPageCursor:(id)pageCursor
+                     ofFetchRequest:(NSFetchRequest *)fetchRequest
+                withRepresentations:(NSArray *)representations
+                       fromResponse:(NSHTTPURLResponse *)response
+{
+    NSNumber *oldestTweetID = [representations valueForKeyPath:@"@min.id"];
+    if (!oldestTweetID) {
+        return nil;
+    }
+    
+    NSNumber *maximumTweetID = [NSNumber numberWithLongLong:[oldestTweetID longLongValue] - 1];
+    
+    return [pageCursor isEqual:maximumTweetID] ? nil : maximumTweetID;
 }
 
 - (BOOL)shouldFetchRemoteAttributeValuesForObjectWithID:(NSManagedObjectID *)objectID